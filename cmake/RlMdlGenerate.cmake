@@ -0,0 +1,37 @@
+# rl_mdl_generate(<variable> <model> <class>)
+#
+# Generates a model-specialized rl::mdl::Dynamic subclass <class> from the
+# model description <model> with rlmdl2cpp and appends the generated header
+# and source file in the current binary directory to <variable>. Uses the
+# rlmdl2cpp target when included from the build tree of rl, the installed
+# rlmdl2cpp executable otherwise.
+
+if(NOT DEFINED rl_SOURCE_DIR)
+	find_program(
+		RLMDL2CPP_EXECUTABLE
+		NAMES rlmdl2cpp
+		HINTS ${CMAKE_CURRENT_LIST_DIR}/../../../bin
+	)
+endif()
+
+function(rl_mdl_generate VARIABLE MODEL CLASS)
+	get_filename_component(MODEL ${MODEL} ABSOLUTE)
+	
+	if(DEFINED rl_SOURCE_DIR)
+		set(RLMDL2CPP rlmdl2cpp)
+	elseif(RLMDL2CPP_EXECUTABLE)
+		set(RLMDL2CPP ${RLMDL2CPP_EXECUTABLE})
+	else()
+		message(FATAL_ERROR "rl_mdl_generate() requires rlmdl2cpp")
+	endif()
+	
+	add_custom_command(
+		OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/${CLASS}.h ${CMAKE_CURRENT_BINARY_DIR}/${CLASS}.cpp
+		COMMAND ${RLMDL2CPP} ${MODEL} ${CLASS} ${CMAKE_CURRENT_BINARY_DIR}/${CLASS}.h ${CMAKE_CURRENT_BINARY_DIR}/${CLASS}.cpp
+		DEPENDS ${RLMDL2CPP} ${MODEL}
+		COMMENT "Generating ${CLASS} from ${MODEL}"
+		VERBATIM
+	)
+	
+	set(${VARIABLE} ${${VARIABLE}} ${CMAKE_CURRENT_BINARY_DIR}/${CLASS}.h ${CMAKE_CURRENT_BINARY_DIR}/${CLASS}.cpp PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <boost/lexical_cast.hpp>
+#include <rl/mdl/DormandPrinceIntegrator.h>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/RungeKuttaNystromIntegrator.h>
+#include <rl/mdl/UrdfFactory.h>
+#include <rl/mdl/XmlFactory.h>
+
+void
+benchmark(const std::string& name, const std::size_t& iterations, const std::function<void()>& function)
+{
+	function();
+	
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		function();
+	}
+	
+	std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+	
+	std::cout << std::left << std::setw(40) << name << std::right << std::setw(12) << std::chrono::duration<double, std::micro>(stop - start).count() / iterations << " us" << std::endl;
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlDynamicsBenchmark MODELFILE [ITERATIONS]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::string filename(argv[1]);
+		std::shared_ptr<rl::mdl::Dynamic> dynamic;
+		
+		if ("urdf" == filename.substr(filename.length() - 4, 4))
+		{
+			rl::mdl::UrdfFactory factory;
+			dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(filename));
+		}
+		else
+		{
+			rl::mdl::XmlFactory factory;
+			dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(filename));
+		}
+		
+		std::size_t iterations = argc > 2 ? boost::lexical_cast<std::size_t>(argv[2]) : 100000;
+		
+		rl::math::Vector q = dynamic->generatePositionUniform();
+		rl::math::Vector qd = rl::math::Vector::Random(dynamic->getDof());
+		rl::math::Vector qdd = rl::math::Vector::Random(dynamic->getDof());
+		rl::math::Vector tau = rl::math::Vector::Random(dynamic->getDof());
+		rl::math::Matrix y(dynamic->getDofPosition(), 64);
+		rl::math::Matrix dq;
+		rl::math::Matrix dqd;
+		rl::math::Matrix dtau;
+		rl::mdl::RungeKuttaNystromIntegrator rungeKuttaNystrom(dynamic.get());
+		rl::mdl::DormandPrinceIntegrator dormandPrince(dynamic.get());
+		
+		for (std::ptrdiff_t i = 0; i < y.cols(); ++i)
+		{
+			y.col(i) = dynamic->generatePositionUniform();
+		}
+		
+		std::cout << dynamic->getName() << ", " << dynamic->getDof() << " DOF, " << iterations << " iterations" << std::endl;
+		
+		dynamic->setPosition(q);
+		dynamic->setVelocity(qd);
+		dynamic->setAcceleration(qdd);
+		dynamic->setTorque(tau);
+		
+		benchmark("forwardPosition", iterations, [&]() { dynamic->forwardPosition(); });
+		benchmark("forwardPosition (batch of 64)", iterations / y.cols() + 1, [&]() { dynamic->forwardPosition(y); });
+		benchmark("inverseDynamics", iterations, [&]() { dynamic->inverseDynamics(); });
+		benchmark("forwardDynamics", iterations, [&]() { dynamic->forwardDynamics(); });
+		benchmark("calculateJacobian", iterations, [&]() { dynamic->calculateJacobian(); });
+		benchmark("calculateJacobianDerivative", iterations, [&]() { dynamic->calculateJacobianDerivative(); });
+		benchmark("calculateInverseDynamicsDerivatives", iterations, [&]() { dynamic->calculateInverseDynamicsDerivatives(dq, dqd); });
+		benchmark("calculateForwardDynamicsDerivatives", iterations, [&]() { dynamic->calculateForwardDynamicsDerivatives(dq, dqd, dtau); });
+		benchmark("calculateMassMatrix", iterations, [&]() { dynamic->calculateMassMatrix(); });
+		benchmark("calculateMassMatrixInverse", iterations, [&]() { dynamic->calculateMassMatrixInverse(); });
+		benchmark("setPosition", iterations, [&]() { dynamic->setPosition(q); });
+		benchmark("RungeKuttaNystromIntegrator (10 ms)", iterations / 10 + 1, [&]() { dynamic->setPosition(q); dynamic->setVelocity(qd); for (std::size_t i = 0; i < 10; ++i) { rungeKuttaNystrom.integrate(0.001); } });
+		benchmark("DormandPrinceIntegrator (10 ms)", iterations / 10 + 1, [&]() { dynamic->setPosition(q); dynamic->setVelocity(qd); dormandPrince.integrate(0.01); });
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
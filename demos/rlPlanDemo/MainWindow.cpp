@@ -50,6 +50,8 @@
 #include <rl/plan/AddRrtConCon.h>
 #include <rl/plan/AdvancedOptimizer.h>
 #include <rl/plan/BridgeSampler.h>
+#include <rl/plan/ClearanceVerifier.h>
+#include <rl/plan/ContinuousVerifier.h>
 #include <rl/plan/DistanceModel.h>
 #include <rl/plan/Eet.h>
 #include <rl/plan/GaussianSampler.h>
@@ -67,6 +69,7 @@
 #include <rl/plan/RrtExtCon.h>
 #include <rl/plan/RrtExtExt.h>
 #include <rl/plan/RrtGoalBias.h>
+#include <rl/plan/RrtStar.h>
 #include <rl/plan/SequentialVerifier.h>
 #include <rl/plan/SimpleModel.h>
 #include <rl/plan/SimpleOptimizer.h>
@@ -941,7 +944,12 @@ MainWindow::load(const QString& filename)
 	rl::sg::XmlFactory sceneFactory;
 	
 	rl::xml::NodeSet modelScene = path.eval("(/rl/plan|/rlplan)//model/scene").getValue<rl::xml::NodeSet>();
-	sceneFactory.load(modelScene[0].getUri(modelScene[0].getProperty("href")), this->scene.get());
+	sceneFactory.load(
+		modelScene[0].getUri(modelScene[0].getProperty("href")),
+		this->scene.get(),
+		path.eval("count((/rl/plan|/rlplan)//clearanceVerifier) > 0").getValue<bool>(),
+		false
+	);
 	this->sceneModel = this->scene->getModel(
 		path.eval("number((/rl/plan|/rlplan)//model/model)").getValue<std::size_t>()
 	);
@@ -1208,7 +1216,27 @@ MainWindow::load(const QString& filename)
 	this->sampler2 = std::make_shared<rl::plan::UniformSampler>();
 	this->sampler2->model = this->model.get();
 	
-	if (path.eval("count((/rl/plan|/rlplan)//recursiveVerifier) > 0").getValue<bool>())
+	if (path.eval("count((/rl/plan|/rlplan)//clearanceVerifier) > 0").getValue<bool>())
+	{
+		this->verifier = std::make_shared<rl::plan::ClearanceVerifier>();
+		this->verifier->delta = path.eval("number((/rl/plan|/rlplan)//clearanceVerifier/delta)").getValue<rl::math::Real>(1);
+		
+		if ("deg" == path.eval("string((/rl/plan|/rlplan)//clearanceVerifier/delta/@unit)").getValue<std::string>())
+		{
+			this->verifier->delta *= rl::math::DEG2RAD;
+		}
+	}
+	else if (path.eval("count((/rl/plan|/rlplan)//continuousVerifier) > 0").getValue<bool>())
+	{
+		this->verifier = std::make_shared<rl::plan::ContinuousVerifier>();
+		this->verifier->delta = path.eval("number((/rl/plan|/rlplan)//continuousVerifier/delta)").getValue<rl::math::Real>(1);
+		
+		if ("deg" == path.eval("string((/rl/plan|/rlplan)//continuousVerifier/delta/@unit)").getValue<std::string>())
+		{
+			this->verifier->delta *= rl::math::DEG2RAD;
+		}
+	}
+	else if (path.eval("count((/rl/plan|/rlplan)//recursiveVerifier) > 0").getValue<bool>())
 	{
 		this->verifier = std::make_shared<rl::plan::RecursiveVerifier>();
 		this->verifier->delta = path.eval("number((/rl/plan|/rlplan)//recursiveVerifier/delta)").getValue<rl::math::Real>(1);
@@ -1286,7 +1314,7 @@ MainWindow::load(const QString& filename)
 		this->optimizer->verifier = this->verifier2.get();
 	}
 	
-	rl::xml::NodeSet planners = path.eval("(/rl/plan|/rlplan)//addRrtConCon|(/rl/plan|/rlplan)//eet|(/rl/plan|/rlplan)//prm|(/rl/plan|/rlplan)//prmUtilityGuided|(/rl/plan|/rlplan)//rrt|(/rl/plan|/rlplan)//rrtCon|(/rl/plan|/rlplan)//rrtConCon|(/rl/plan|/rlplan)//rrtConExt|(/rl/plan|/rlplan)//rrtDual|(/rl/plan|/rlplan)//rrtGoalBias|(/rl/plan|/rlplan)//rrtExtCon|(/rl/plan|/rlplan)//rrtExtExt").getValue<rl::xml::NodeSet>();
+	rl::xml::NodeSet planners = path.eval("(/rl/plan|/rlplan)//addRrtConCon|(/rl/plan|/rlplan)//eet|(/rl/plan|/rlplan)//prm|(/rl/plan|/rlplan)//prmUtilityGuided|(/rl/plan|/rlplan)//rrt|(/rl/plan|/rlplan)//rrtCon|(/rl/plan|/rlplan)//rrtConCon|(/rl/plan|/rlplan)//rrtConExt|(/rl/plan|/rlplan)//rrtDual|(/rl/plan|/rlplan)//rrtGoalBias|(/rl/plan|/rlplan)//rrtExtCon|(/rl/plan|/rlplan)//rrtExtExt|(/rl/plan|/rlplan)//rrtStar").getValue<rl::xml::NodeSet>();
 	
 	for (int i = 0; i < std::min(1, planners.size()); ++i)
 	{
@@ -1718,6 +1746,46 @@ MainWindow::load(const QString& filename)
 				rrtGoalBias->seed(*this->seed);
 			}
 		}
+		else if ("rrtStar" == planners[i].getName())
+		{
+			this->planner = std::make_shared<rl::plan::RrtStar>();
+			rl::plan::RrtStar* rrtStar = static_cast<rl::plan::RrtStar*>(this->planner.get());
+			rrtStar->delta = path.eval("number(delta)").getValue<rl::math::Real>(1);
+			
+			if ("deg" == path.eval("string(delta/@unit)").getValue<std::string>())
+			{
+				rrtStar->delta *= rl::math::DEG2RAD;
+			}
+			
+			rrtStar->epsilon = path.eval("number(epsilon)").getValue<rl::math::Real>(static_cast<rl::math::Real>(1.0e-3));
+			
+			if ("deg" == path.eval("string(epsilon/@unit)").getValue<std::string>())
+			{
+				rrtStar->epsilon *= rl::math::DEG2RAD;
+			}
+			
+			rrtStar->gamma = path.eval("number(gamma)").getValue<rl::math::Real>(0);
+			
+			if (path.eval("count(uninformed) > 0").getValue<bool>())
+			{
+				rrtStar->informed = false;
+			}
+			
+			rrtStar->probability = path.eval("number(probability)").getValue<rl::math::Real>(static_cast<rl::math::Real>(0.05));
+			rrtStar->sampler = this->sampler.get();
+			rrtStar->verifier = this->verifier.get();
+			
+			if (path.eval("count(seed) > 0").getValue<bool>())
+			{
+				rrtStar->seed(
+					path.eval("number(seed)").getValue<std::mt19937::result_type>(std::random_device()())
+				);
+			}
+			else if (this->seed)
+			{
+				rrtStar->seed(*this->seed);
+			}
+		}
 	}
 	
 	std::size_t nearestNeighborsSize = 1;
@@ -0,0 +1,893 @@
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <rl/mdl/Body.h>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/Joint.h>
+#include <rl/mdl/Prismatic.h>
+#include <rl/mdl/Revolute.h>
+#include <rl/mdl/Transform.h>
+#include <rl/mdl/UrdfFactory.h>
+#include <rl/mdl/World.h>
+#include <rl/mdl/XmlFactory.h>
+
+static const std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+struct Anchor
+{
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	
+	/** Link the frame is rigidly attached to, npos if attached to the root. */
+	std::size_t link;
+	
+	/** Fixed transform from the link frame to the frame. */
+	rl::math::PlueckerTransform x;
+};
+
+struct Link
+{
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	
+	/** Bodies rigidly attached to the link with their fixed transform from the link frame. */
+	std::vector<std::pair<std::size_t, rl::math::PlueckerTransform>, Eigen::aligned_allocator<std::pair<std::size_t, rl::math::PlueckerTransform>>> bodies;
+	
+	/** Composite rigid body inertia of all attached bodies in the link frame. */
+	rl::math::RigidBodyInertia i;
+	
+	std::size_t joint;
+	
+	/** Parent link, npos if attached to the root. */
+	std::size_t parent;
+	
+	/** Motion subspace. */
+	rl::math::Vector6 s;
+	
+	/** Fixed transform from the parent link frame to the joint. */
+	rl::math::PlueckerTransform t;
+	
+	std::size_t transform;
+};
+
+static bool
+isIdentity(const rl::math::PlueckerTransform& x)
+{
+	return x.transform().matrix() == rl::math::Matrix44::Identity();
+}
+
+static bool
+isZero(const rl::math::RigidBodyInertia& i)
+{
+	return 0 == i.mass() && i.cog().isZero(0) && i.inertia().isZero(0);
+}
+
+static std::string
+real(const rl::math::Real& r)
+{
+	std::ostringstream stream;
+	stream << std::setprecision(std::numeric_limits<rl::math::Real>::max_digits10) << r;
+	return stream.str();
+}
+
+template<typename Derived>
+static std::string
+list(const Eigen::DenseBase<Derived>& m)
+{
+	std::string s;
+	
+	for (std::ptrdiff_t i = 0; i < m.rows(); ++i)
+	{
+		for (std::ptrdiff_t j = 0; j < m.cols(); ++j)
+		{
+			s += (s.empty() ? "" : ", ") + real(m(i, j));
+		}
+	}
+	
+	return s;
+}
+
+static void
+emitInertia(std::ostream& out, const std::string& indent, const std::string& name, const rl::math::RigidBodyInertia& i)
+{
+	out << indent << "::rl::math::RigidBodyInertia " << name << ";" << std::endl;
+	out << indent << name << ".cog() << " << list(i.cog()) << ";" << std::endl;
+	out << indent << name << ".inertia() << " << list(i.inertia()) << ";" << std::endl;
+	out << indent << name << ".mass() = " << real(i.mass()) << ";" << std::endl;
+}
+
+static void
+emitMotion(std::ostream& out, const std::string& indent, const std::string& name, const rl::math::Vector6& s)
+{
+	out << indent << "::rl::math::MotionVector " << name << ";" << std::endl;
+	out << indent << name << ".angular() << " << list(s.head<3>()) << ";" << std::endl;
+	out << indent << name << ".linear() << " << list(s.tail<3>()) << ";" << std::endl;
+}
+
+static void
+emitTransform(std::ostream& out, const std::string& indent, const std::string& name, const rl::math::PlueckerTransform& x)
+{
+	out << indent << "::rl::math::PlueckerTransform " << name << ";" << std::endl;
+	out << indent << name << ".linear() << " << list(x.linear()) << ";" << std::endl;
+	out << indent << name << ".translation() << " << list(x.translation()) << ";" << std::endl;
+	out << indent << name << ".transform().makeAffine();" << std::endl;
+}
+
+/**
+ * Index of the single unit coefficient of a motion subspace, -1 otherwise.
+ *
+ * Revolute and prismatic joints about a principal axis reduce S^T * f to
+ * selecting one coefficient.
+ */
+static std::ptrdiff_t
+unit(const rl::math::Vector6& s)
+{
+	std::ptrdiff_t index;
+	
+	if (1 == (s.array() != 0).count() && 1 == s.cwiseAbs().maxCoeff(&index))
+	{
+		return index;
+	}
+	
+	return -1;
+}
+
+/** Projection of a spatial vector onto a single degree of freedom, S^T * f. */
+static std::string
+project(const Link& link, const std::size_t& k, const std::string& f)
+{
+	std::ptrdiff_t index = unit(link.s);
+	
+	if (index >= 0)
+	{
+		return (link.s(index) < 0 ? "-" : "") + f + ".matrix()(" + std::to_string(index) + ")";
+	}
+	
+	return "s" + std::to_string(k) + ".matrix().dot(" + f + ".matrix())";
+}
+
+/** Coefficient of a rotation entry, rounding off residues of angles like 90 degrees. */
+static bool
+isZero(const rl::math::Real& r)
+{
+	return std::abs(r) <= std::numeric_limits<rl::math::Real>::epsilon();
+}
+
+/** Sum of constant and coefficient-weighted terms, omitting zero terms. */
+static std::string
+sum(const std::vector<std::pair<rl::math::Real, std::string>>& terms)
+{
+	std::string s;
+	
+	for (std::size_t i = 0; i < terms.size(); ++i)
+	{
+		if (isZero(terms[i].first))
+		{
+			continue;
+		}
+		
+		std::string factor;
+		
+		if (terms[i].second.empty())
+		{
+			factor = real(std::abs(terms[i].first));
+		}
+		else if (1 == std::abs(terms[i].first))
+		{
+			factor = terms[i].second;
+		}
+		else
+		{
+			factor = real(std::abs(terms[i].first)) + " * " + terms[i].second;
+		}
+		
+		if (s.empty())
+		{
+			s = (terms[i].first < 0 ? "-" : "") + factor;
+		}
+		else
+		{
+			s += (terms[i].first < 0 ? " - " : " + ") + factor;
+		}
+	}
+	
+	return s.empty() ? "0" : s;
+}
+
+/**
+ * Transform from the parent link frame to the link frame.
+ *
+ * The fixed transform to the joint, the joint axis, and the joint offset are
+ * folded into constants, leaving only the entries depending on the joint
+ * position. With R = a * a^T + cos(q) * (I - a * a^T) + sin(q) * [a]x for a
+ * revolute joint, every rotation entry is a constant combination of cos(q)
+ * and sin(q), a prismatic joint only adds a translation linear in q.
+ */
+static void
+emitTransforms(std::ostream& out, const rl::mdl::Model* model, const std::vector<Link, Eigen::aligned_allocator<Link>>& links)
+{
+	for (std::size_t k = 0; k < links.size(); ++k)
+	{
+		const rl::mdl::Joint* joint = model->getJoint(links[k].joint);
+		std::string q = "this->joints[" + std::to_string(links[k].joint) + "]->q(0)";
+		
+		if (0 != joint->offset(0))
+		{
+			q += " + " + real(joint->offset(0));
+		}
+		
+		std::string entries[3][3];
+		std::string position[3];
+		
+		if (nullptr != dynamic_cast<const rl::mdl::Revolute*>(joint))
+		{
+			rl::math::Vector3 a = links[k].s.head<3>();
+			rl::math::Matrix33 axis = links[k].t.linear() * a * a.transpose();
+			rl::math::Matrix33 cosine = links[k].t.linear() * (rl::math::Matrix33::Identity() - a * a.transpose());
+			rl::math::Matrix33 cross;
+			cross << 0, -a.z(), a.y(), a.z(), 0, -a.x(), -a.y(), a.x(), 0;
+			rl::math::Matrix33 sine = links[k].t.linear() * cross;
+			
+			for (std::size_t i = 0; i < 3; ++i)
+			{
+				for (std::size_t j = 0; j < 3; ++j)
+				{
+					entries[i][j] = sum({{axis(i, j), ""}, {cosine(i, j), "cq" + std::to_string(k)}, {sine(i, j), "sq" + std::to_string(k)}});
+				}
+			}
+			
+			rl::math::Vector3 translation = links[k].t.translation() + links[k].t.linear() * joint->x.translation();
+			
+			for (std::size_t i = 0; i < 3; ++i)
+			{
+				position[i] = sum({{translation(i), ""}});
+			}
+			
+			out << "\t::rl::math::Real cq" << k << " = ::std::cos(" << q << ");" << std::endl;
+			out << "\t::rl::math::Real sq" << k << " = ::std::sin(" << q << ");" << std::endl;
+		}
+		else
+		{
+			rl::math::Matrix33 linear = links[k].t.linear() * joint->x.linear();
+			rl::math::Vector3 a = links[k].t.linear() * links[k].s.tail<3>();
+			
+			for (std::size_t i = 0; i < 3; ++i)
+			{
+				for (std::size_t j = 0; j < 3; ++j)
+				{
+					entries[i][j] = isZero(linear(i, j)) ? "0" : real(linear(i, j));
+				}
+				
+				position[i] = sum({{links[k].t.translation()(i), ""}, {a(i), 0 != joint->offset(0) ? "(" + q + ")" : q}});
+			}
+		}
+		
+		out << "\t::rl::math::PlueckerTransform x" << k << ";" << std::endl;
+		out << "\tx" << k << ".linear() <<";
+		
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			for (std::size_t j = 0; j < 3; ++j)
+			{
+				out << (0 == i && 0 == j ? " " : ", ") << entries[i][j];
+			}
+		}
+		
+		out << ";" << std::endl;
+		out << "\tx" << k << ".translation() << " << position[0] << ", " << position[1] << ", " << position[2] << ";" << std::endl;
+		out << "\tx" << k << ".transform().makeAffine();" << std::endl;
+		out << "\t" << std::endl;
+	}
+}
+
+static void
+emitExternalForces(std::ostream& out, const Link& link, const std::string& f)
+{
+	for (std::size_t j = 0; j < link.bodies.size(); ++j)
+	{
+		std::string body = "this->bodies[" + std::to_string(link.bodies[j].first) + "]";
+		out << "\t" << std::endl;
+		out << "\tif (!" << body << "->fX.matrix().isZero(0))" << std::endl;
+		out << "\t{" << std::endl;
+		
+		if (isIdentity(link.bodies[j].second))
+		{
+			out << "\t\t" << f << " -= " << body << "->x * " << body << "->fX;" << std::endl;
+		}
+		else
+		{
+			emitTransform(out, "\t\t", "k", link.bodies[j].second);
+			out << "\t\t" << f << " -= k / (" << body << "->x * " << body << "->fX);" << std::endl;
+		}
+		
+		out << "\t}" << std::endl;
+	}
+}
+
+static void
+emitVelocities(std::ostream& out, const std::vector<Link, Eigen::aligned_allocator<Link>>& links, const std::size_t& k)
+{
+	if (npos == links[k].parent)
+	{
+		out << "\t::rl::math::MotionVector v" << k << " = this->joints[" << links[k].joint << "]->v;" << std::endl;
+	}
+	else
+	{
+		out << "\t::rl::math::MotionVector v" << k << " = x" << k << " * v" << links[k].parent << " + this->joints[" << links[k].joint << "]->v;" << std::endl;
+	}
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc != 5)
+	{
+		std::cerr << "Usage: rlmdl2cpp MODELFILE CLASSNAME HEADERFILE SOURCEFILE" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::string filename(argv[1]);
+		std::string name(argv[2]);
+		std::string header(argv[3]);
+		
+		std::shared_ptr<rl::mdl::Model> model;
+		
+		if ("urdf" == filename.substr(filename.length() - 4, 4))
+		{
+			rl::mdl::UrdfFactory factory;
+			model = factory.create(filename);
+		}
+		else
+		{
+			rl::mdl::XmlFactory factory;
+			model = factory.create(filename);
+		}
+		
+		std::unordered_map<const rl::mdl::Frame*, Anchor> anchors;
+		std::unordered_map<const rl::mdl::Frame*, std::size_t> outs;
+		std::vector<Link, Eigen::aligned_allocator<Link>> links;
+		std::vector<std::size_t> tools;
+		
+		anchors[model->getWorld()].link = npos;
+		anchors[model->getWorld()].x.setIdentity();
+		
+		for (std::size_t i = 0; i < model->getOperationalDof(); ++i)
+		{
+			for (std::size_t t = 0; t < model->getTransforms(); ++t)
+			{
+				if (&model->getTransform(t)->x.transform() == &model->tool(i))
+				{
+					tools.push_back(t);
+				}
+			}
+		}
+		
+		// transforms are in depth-first order, parents precede their children
+		for (std::size_t t = 0, k = 0; t < model->getTransforms(); ++t)
+		{
+			rl::mdl::Transform* transform = model->getTransform(t);
+			
+			if (anchors.end() == anchors.find(transform->in))
+			{
+				throw std::runtime_error("Transform '" + transform->getName() + "' is not connected to the world frame");
+			}
+			
+			const Anchor& in = anchors[transform->in];
+			Anchor& out = anchors[transform->out];
+			outs[transform->out] = t;
+			
+			if (k < model->getJoints() && model->getJoint(k) == transform)
+			{
+				if (nullptr == dynamic_cast<rl::mdl::Prismatic*>(transform) && nullptr == dynamic_cast<rl::mdl::Revolute*>(transform))
+				{
+					throw std::runtime_error("Joint '" + transform->getName() + "' is not supported, only prismatic and revolute joints are");
+				}
+				
+				Link link;
+				link.i = rl::math::RigidBodyInertia::Zero();
+				link.joint = k;
+				link.parent = in.link;
+				link.s = model->getJoint(k)->S.col(0);
+				link.t = in.x;
+				link.transform = t;
+				links.push_back(link);
+				
+				out.link = links.size() - 1;
+				out.x.setIdentity();
+				++k;
+			}
+			else
+			{
+				out.link = in.link;
+				out.x = in.x * transform->x;
+			}
+			
+			if (rl::mdl::Body* body = dynamic_cast<rl::mdl::Body*>(transform->out))
+			{
+				if (npos != out.link)
+				{
+					for (std::size_t b = 0; b < model->getBodies(); ++b)
+					{
+						if (model->getBody(b) == body)
+						{
+							links[out.link].bodies.push_back(std::make_pair(b, out.x));
+						}
+					}
+					
+					links[out.link].i = links[out.link].i + out.x / body->i;
+				}
+			}
+		}
+		
+		std::string guard;
+		
+		for (std::size_t i = 0; i < name.size(); ++i)
+		{
+			guard += std::toupper(name[i]);
+		}
+		
+		guard += "_H";
+		
+		std::ofstream h(argv[3]);
+		
+		h << "// Generated by rlmdl2cpp from " << filename << ", do not edit." << std::endl;
+		h << std::endl;
+		h << "#ifndef " << guard << std::endl;
+		h << "#define " << guard << std::endl;
+		h << std::endl;
+		h << "#include <rl/mdl/Dynamic.h>" << std::endl;
+		h << std::endl;
+		h << "/**" << std::endl;
+		h << " * Model-specialized kinematics and dynamics of " << model->getManufacturer() << " " << model->getName() << "." << std::endl;
+		h << " *" << std::endl;
+		h << " * Load the model description into an instance with rl::mdl::XmlFactory::load()." << std::endl;
+		h << " * Fixed transforms, joint axes and offsets, and body inertias are folded into" << std::endl;
+		h << " * constants at generation time, leaving only the sine and cosine of revolute" << std::endl;
+		h << " * joint positions. Only forwardPosition() and the tool transforms of the" << std::endl;
+		h << " * Jacobian follow later changes of the model, the dynamics use the values of" << std::endl;
+		h << " * the model file." << std::endl;
+		h << " * Inverse and forward dynamics only calculate joint torques and accelerations." << std::endl;
+		h << " */" << std::endl;
+		h << "class " << name << " : public ::rl::mdl::Dynamic" << std::endl;
+		h << "{" << std::endl;
+		h << "public:" << std::endl;
+		h << "\tEIGEN_MAKE_ALIGNED_OPERATOR_NEW" << std::endl;
+		h << "\t" << std::endl;
+		h << "\t" << name << "();" << std::endl;
+		h << "\t" << std::endl;
+		h << "\tvirtual ~" << name << "();" << std::endl;
+		h << "\t" << std::endl;
+		h << "\tusing ::rl::mdl::Dynamic::calculateJacobian;" << std::endl;
+		h << "\t" << std::endl;
+		h << "\tvoid calculateJacobian(::rl::math::Matrix& J, const bool& inWorldFrame = true);" << std::endl;
+		h << "\t" << std::endl;
+		h << "\tusing ::rl::mdl::Dynamic::calculateMassMatrix;" << std::endl;
+		h << "\t" << std::endl;
+		h << "\tvoid calculateMassMatrix(::rl::math::Matrix& M);" << std::endl;
+		h << "\t" << std::endl;
+		h << "\t" << name << "* clone() const;" << std::endl;
+		h << "\t" << std::endl;
+		h << "\tvoid forwardDynamics();" << std::endl;
+		h << "\t" << std::endl;
+		h << "\tusing ::rl::mdl::Dynamic::forwardPosition;" << std::endl;
+		h << "\t" << std::endl;
+		h << "\tvoid forwardPosition();" << std::endl;
+		h << "\t" << std::endl;
+		h << "\tvoid inverseDynamics();" << std::endl;
+		h << "\t" << std::endl;
+		h << "\tvoid update();" << std::endl;
+		h << "\t" << std::endl;
+		h << "protected:" << std::endl;
+		h << "\t" << std::endl;
+		h << "private:" << std::endl;
+		h << "\t" << std::endl;
+		h << "};" << std::endl;
+		h << std::endl;
+		h << "#endif // " << guard << std::endl;
+		
+		std::ofstream cpp(argv[4]);
+		
+		cpp << "// Generated by rlmdl2cpp from " << filename << ", do not edit." << std::endl;
+		cpp << std::endl;
+		cpp << "#include <rl/mdl/Body.h>" << std::endl;
+		cpp << "#include <rl/mdl/Exception.h>" << std::endl;
+		cpp << "#include <rl/mdl/Frame.h>" << std::endl;
+		cpp << "#include <rl/mdl/Joint.h>" << std::endl;
+		cpp << "#include <rl/mdl/Prismatic.h>" << std::endl;
+		cpp << "#include <rl/mdl/Revolute.h>" << std::endl;
+		cpp << "#include <rl/mdl/Transform.h>" << std::endl;
+		cpp << std::endl;
+		cpp << "#include \"" << header.substr(header.find_last_of("/\\") + 1) << "\"" << std::endl;
+		cpp << std::endl;
+		
+		// constructor, destructor, clone
+		
+		cpp << name << "::" << name << "() :" << std::endl;
+		cpp << "\tDynamic()" << std::endl;
+		cpp << "{" << std::endl;
+		cpp << "}" << std::endl;
+		cpp << std::endl;
+		cpp << name << "::~" << name << "()" << std::endl;
+		cpp << "{" << std::endl;
+		cpp << "}" << std::endl;
+		cpp << std::endl;
+		
+		// calculateJacobian
+		
+		cpp << "void" << std::endl;
+		cpp << name << "::calculateJacobian(::rl::math::Matrix& J, const bool& inWorldFrame)" << std::endl;
+		cpp << "{" << std::endl;
+		
+		for (std::size_t k = 0; k < links.size(); ++k)
+		{
+			emitMotion(cpp, "\t", "s" + std::to_string(k), links[k].s);
+			cpp << "\t" << std::endl;
+		}
+		
+		cpp << "\tJ.setZero();" << std::endl;
+		
+		for (std::size_t j = 0; j < tools.size(); ++j)
+		{
+			cpp << "\t" << std::endl;
+			cpp << "\t{" << std::endl;
+			cpp << "\t\t::rl::math::Matrix33 r = ::rl::math::Matrix33::Identity();" << std::endl;
+			cpp << "\t\t" << std::endl;
+			cpp << "\t\tif (inWorldFrame)" << std::endl;
+			cpp << "\t\t{" << std::endl;
+			cpp << "\t\t\tr = this->getOperationalPosition(" << j << ").linear();" << std::endl;
+			cpp << "\t\t}" << std::endl;
+			cpp << "\t\t" << std::endl;
+			cpp << "\t\t// motion transform from current frame to operational frame" << std::endl;
+			cpp << "\t\t::rl::math::PlueckerTransform x;" << std::endl;
+			cpp << "\t\t::rl::math::MotionVector xs;" << std::endl;
+			
+			rl::math::PlueckerTransform pending = rl::math::PlueckerTransform::Identity();
+			bool identity = true;
+			
+			for (std::size_t t = tools[j]; npos != t; t = outs.count(model->getTransform(t)->in) > 0 ? outs[model->getTransform(t)->in] : npos)
+			{
+				rl::mdl::Transform* transform = model->getTransform(t);
+				std::size_t k = npos;
+				
+				for (std::size_t l = 0; l < links.size(); ++l)
+				{
+					if (links[l].transform == t)
+					{
+						k = l;
+					}
+				}
+				
+				if (npos == k && t != tools[j])
+				{
+					pending = transform->x * pending;
+					continue;
+				}
+				
+				if (!isIdentity(pending))
+				{
+					cpp << "\t\t" << std::endl;
+					cpp << "\t\t{" << std::endl;
+					emitTransform(cpp, "\t\t\t", "p", pending);
+					cpp << "\t\t\tx = " << (identity ? "p" : "p * x") << ";" << std::endl;
+					cpp << "\t\t}" << std::endl;
+					pending.setIdentity();
+					identity = false;
+				}
+				
+				cpp << "\t\t" << std::endl;
+				
+				if (npos != k)
+				{
+					cpp << "\t\txs = " << (identity ? "" : "x * ") << "s" << k << ";" << std::endl;
+					cpp << "\t\tJ.block<3, 1>(" << j * 6 << ", " << links[k].joint << ") = r * xs.linear();" << std::endl;
+					cpp << "\t\tJ.block<3, 1>(" << j * 6 + 3 << ", " << links[k].joint << ") = r * xs.angular();" << std::endl;
+					
+					if (npos == links[k].parent)
+					{
+						break;
+					}
+				}
+				
+				cpp << "\t\tx = this->transforms[" << t << "]->x" << (identity ? "" : " * x") << ";" << std::endl;
+				identity = false;
+			}
+			
+			cpp << "\t}" << std::endl;
+		}
+		
+		cpp << "\t" << std::endl;
+		cpp << "\tif (!this->gammaVelocityIdentity)" << std::endl;
+		cpp << "\t{" << std::endl;
+		cpp << "\t\tJ = J * this->gammaVelocity;" << std::endl;
+		cpp << "\t}" << std::endl;
+		cpp << "}" << std::endl;
+		cpp << std::endl;
+		
+		// calculateMassMatrix
+		
+		cpp << "void" << std::endl;
+		cpp << name << "::calculateMassMatrix(::rl::math::Matrix& M)" << std::endl;
+		cpp << "{" << std::endl;
+		
+		emitTransforms(cpp, model.get(), links);
+		
+		for (std::size_t k = 0; k < links.size(); ++k)
+		{
+			if (isZero(links[k].i))
+			{
+				cpp << "\t::rl::math::RigidBodyInertia i" << k << " = ::rl::math::RigidBodyInertia::Zero();" << std::endl;
+			}
+			else
+			{
+				emitInertia(cpp, "\t", "i" + std::to_string(k), links[k].i);
+			}
+			
+			emitMotion(cpp, "\t", "s" + std::to_string(k), links[k].s);
+			cpp << "\t" << std::endl;
+		}
+		
+		cpp << "\t// composite rigid body inertias" << std::endl;
+		
+		for (std::size_t k = links.size(); k-- > 0;)
+		{
+			if (npos != links[k].parent)
+			{
+				cpp << "\ti" << links[k].parent << " = i" << links[k].parent << " + x" << k << " / i" << k << ";" << std::endl;
+			}
+		}
+		
+		cpp << "\t" << std::endl;
+		
+		std::size_t entries = 0;
+		
+		for (std::size_t k = 0; k < links.size(); ++k)
+		{
+			++entries;
+			
+			for (std::size_t l = k; npos != links[l].parent; l = links[l].parent)
+			{
+				entries += 2;
+			}
+		}
+		
+		if (entries < links.size() * links.size())
+		{
+			// branched models have zero entries between unrelated links
+			cpp << "\tM.setZero(" << links.size() << ", " << links.size() << ");" << std::endl;
+		}
+		else
+		{
+			cpp << "\tM.resize(" << links.size() << ", " << links.size() << ");" << std::endl;
+		}
+		
+		cpp << "\t" << std::endl;
+		
+		cpp << "\t::rl::math::ForceVector f;" << std::endl;
+		
+		for (std::size_t k = 0; k < links.size(); ++k)
+		{
+			cpp << "\t" << std::endl;
+			cpp << "\tf = i" << k << " * s" << k << ";" << std::endl;
+			cpp << "\tM(" << links[k].joint << ", " << links[k].joint << ") = " << project(links[k], k, "f") << ";" << std::endl;
+			
+			for (std::size_t l = k; npos != links[l].parent; l = links[l].parent)
+			{
+				std::size_t p = links[l].parent;
+				cpp << "\tf = x" << l << " / f;" << std::endl;
+				cpp << "\tM(" << links[p].joint << ", " << links[k].joint << ") = " << project(links[p], p, "f") << ";" << std::endl;
+				cpp << "\tM(" << links[k].joint << ", " << links[p].joint << ") = M(" << links[p].joint << ", " << links[k].joint << ");" << std::endl;
+			}
+		}
+		
+		cpp << "\t" << std::endl;
+		cpp << "\tif (!this->gammaVelocityIdentity)" << std::endl;
+		cpp << "\t{" << std::endl;
+		cpp << "\t\tM = M * this->gammaVelocity;" << std::endl;
+		cpp << "\t}" << std::endl;
+		cpp << "}" << std::endl;
+		cpp << std::endl;
+		
+		// clone
+		
+		cpp << name << "*" << std::endl;
+		cpp << name << "::clone() const" << std::endl;
+		cpp << "{" << std::endl;
+		cpp << "\treturn new " << name << "(*this);" << std::endl;
+		cpp << "}" << std::endl;
+		cpp << std::endl;
+		
+		// forwardDynamics
+		
+		cpp << "void" << std::endl;
+		cpp << name << "::forwardDynamics()" << std::endl;
+		cpp << "{" << std::endl;
+		cpp << "\t::rl::math::MotionVector a;" << std::endl;
+		cpp << "\ta.angular().setZero();" << std::endl;
+		cpp << "\ta.linear() = this->getWorldGravity();" << std::endl;
+		cpp << "\t" << std::endl;
+		
+		emitTransforms(cpp, model.get(), links);
+		
+		for (std::size_t k = 0; k < links.size(); ++k)
+		{
+			emitMotion(cpp, "\t", "s" + std::to_string(k), links[k].s);
+			emitVelocities(cpp, links, k);
+			
+			if (npos == links[k].parent)
+			{
+				cpp << "\t::rl::math::MotionVector c" << k << " = ::rl::math::MotionVector::Zero();" << std::endl;
+			}
+			else
+			{
+				cpp << "\t::rl::math::MotionVector c" << k << " = v" << k << ".cross(this->joints[" << links[k].joint << "]->v);" << std::endl;
+			}
+			
+			if (isZero(links[k].i))
+			{
+				cpp << "\t::rl::math::ArticulatedBodyInertia ia" << k << " = ::rl::math::ArticulatedBodyInertia::Zero();" << std::endl;
+				cpp << "\t::rl::math::ForceVector pa" << k << " = ::rl::math::ForceVector::Zero();" << std::endl;
+			}
+			else
+			{
+				emitInertia(cpp, "\t", "i" + std::to_string(k), links[k].i);
+				cpp << "\t::rl::math::ArticulatedBodyInertia ia" << k << ";" << std::endl;
+				cpp << "\tia" << k << " = i" << k << ";" << std::endl;
+				cpp << "\t::rl::math::ForceVector pa" << k << " = v" << k << ".cross(i" << k << " * v" << k << ");" << std::endl;
+			}
+			
+			emitExternalForces(cpp, links[k], "pa" + std::to_string(k));
+			cpp << "\t" << std::endl;
+		}
+		
+		for (std::size_t k = links.size(); k-- > 0;)
+		{
+			cpp << "\t::rl::math::ForceVector U" << k << " = ia" << k << " * s" << k << ";" << std::endl;
+			cpp << "\t::rl::math::Real D" << k << " = " << project(links[k], k, "U" + std::to_string(k)) << ";" << std::endl;
+			cpp << "\t::rl::math::Real u" << k << " = this->joints[" << links[k].joint << "]->tau(0) - " << project(links[k], k, "pa" + std::to_string(k)) << ";" << std::endl;
+			
+			if (npos != links[k].parent)
+			{
+				std::size_t p = links[k].parent;
+				cpp << "\t" << std::endl;
+				cpp << "\t{" << std::endl;
+				cpp << "\t\t::rl::math::ArticulatedBodyInertia ia(ia" << k << " - ::rl::math::ArticulatedBodyInertia(U" << k << ".matrix() * U" << k << ".matrix().transpose() / D" << k << "));" << std::endl;
+				cpp << "\t\t::rl::math::ForceVector pa(pa" << k << " + ia * c" << k << " + U" << k << " * (u" << k << " / D" << k << "));" << std::endl;
+				cpp << "\t\tia" << p << " = ia" << p << " + x" << k << " / ia;" << std::endl;
+				cpp << "\t\tpa" << p << " = pa" << p << " + x" << k << " / pa;" << std::endl;
+				cpp << "\t}" << std::endl;
+			}
+			
+			cpp << "\t" << std::endl;
+		}
+		
+		for (std::size_t k = 0; k < links.size(); ++k)
+		{
+			cpp << "\t::rl::math::MotionVector a" << k << " = x" << k << " * " << (npos == links[k].parent ? std::string("a") : "a" + std::to_string(links[k].parent)) << " + c" << k << ";" << std::endl;
+			cpp << "\tthis->joints[" << links[k].joint << "]->qdd(0) = (u" << k << " - U" << k << ".matrix().dot(a" << k << ".matrix())) / D" << k << ";" << std::endl;
+			cpp << "\tthis->joints[" << links[k].joint << "]->a = s" << k << " * this->joints[" << links[k].joint << "]->qdd(0);" << std::endl;
+			cpp << "\ta" << k << " += this->joints[" << links[k].joint << "]->a;" << std::endl;
+			
+			if (k + 1 < links.size())
+			{
+				cpp << "\t" << std::endl;
+			}
+		}
+		
+		cpp << "}" << std::endl;
+		cpp << std::endl;
+		
+		// forwardPosition
+		
+		cpp << "void" << std::endl;
+		cpp << name << "::forwardPosition()" << std::endl;
+		cpp << "{" << std::endl;
+		
+		for (std::size_t t = 0; t < model->getTransforms(); ++t)
+		{
+			cpp << "\tthis->transforms[" << t << "]->out->x = this->transforms[" << t << "]->in->x * this->transforms[" << t << "]->x;" << std::endl;
+		}
+		
+		cpp << "\t" << std::endl;
+		cpp << "\tthis->touchBodyFrames();" << std::endl;
+		cpp << "}" << std::endl;
+		cpp << std::endl;
+		
+		// inverseDynamics
+		
+		cpp << "void" << std::endl;
+		cpp << name << "::inverseDynamics()" << std::endl;
+		cpp << "{" << std::endl;
+		cpp << "\t::rl::math::MotionVector a;" << std::endl;
+		cpp << "\ta.angular().setZero();" << std::endl;
+		cpp << "\ta.linear() = this->getWorldGravity();" << std::endl;
+		cpp << "\t" << std::endl;
+		
+		emitTransforms(cpp, model.get(), links);
+		
+		for (std::size_t k = 0; k < links.size(); ++k)
+		{
+			emitVelocities(cpp, links, k);
+			
+			if (npos == links[k].parent)
+			{
+				cpp << "\t::rl::math::MotionVector a" << k << " = x" << k << " * a + this->joints[" << links[k].joint << "]->a;" << std::endl;
+			}
+			else
+			{
+				cpp << "\t::rl::math::MotionVector a" << k << " = x" << k << " * a" << links[k].parent << " + this->joints[" << links[k].joint << "]->a + v" << k << ".cross(this->joints[" << links[k].joint << "]->v);" << std::endl;
+			}
+			
+			if (isZero(links[k].i))
+			{
+				cpp << "\t::rl::math::ForceVector f" << k << " = ::rl::math::ForceVector::Zero();" << std::endl;
+			}
+			else
+			{
+				emitInertia(cpp, "\t", "i" + std::to_string(k), links[k].i);
+				cpp << "\t::rl::math::ForceVector f" << k << " = i" << k << " * a" << k << " + v" << k << ".cross(i" << k << " * v" << k << ");" << std::endl;
+			}
+			
+			emitExternalForces(cpp, links[k], "f" + std::to_string(k));
+			cpp << "\t" << std::endl;
+		}
+		
+		for (std::size_t k = links.size(); k-- > 0;)
+		{
+			if (unit(links[k].s) < 0)
+			{
+				emitMotion(cpp, "\t", "s" + std::to_string(k), links[k].s);
+			}
+			
+			cpp << "\tthis->joints[" << links[k].joint << "]->tau(0) = " << project(links[k], k, "f" + std::to_string(k)) << ";" << std::endl;
+			
+			if (npos != links[k].parent)
+			{
+				cpp << "\tf" << links[k].parent << " = f" << links[k].parent << " + x" << k << " / f" << k << ";" << std::endl;
+			}
+		}
+		
+		cpp << "}" << std::endl;
+		cpp << std::endl;
+		
+		// update
+		
+		cpp << "void" << std::endl;
+		cpp << name << "::update()" << std::endl;
+		cpp << "{" << std::endl;
+		cpp << "\tDynamic::update();" << std::endl;
+		cpp << "\t" << std::endl;
+		cpp << "\tif (" << model->getTransforms() << " != this->transforms.size() || " << model->getJoints() << " != this->joints.size())" << std::endl;
+		cpp << "\t{" << std::endl;
+		cpp << "\t\tthrow ::rl::mdl::Exception(\"" << name << "::update() - Model does not match generated code\");" << std::endl;
+		cpp << "\t}" << std::endl;
+		
+		for (std::size_t k = 0; k < links.size(); ++k)
+		{
+			std::string type = nullptr != dynamic_cast<rl::mdl::Revolute*>(model->getJoint(links[k].joint)) ? "Revolute" : "Prismatic";
+			cpp << "\t" << std::endl;
+			cpp << "\tif (this->joints[" << links[k].joint << "] != this->transforms[" << links[k].transform << "] || nullptr == dynamic_cast<::rl::mdl::" << type << "*>(this->joints[" << links[k].joint << "]))" << std::endl;
+			cpp << "\t{" << std::endl;
+			cpp << "\t\tthrow ::rl::mdl::Exception(\"" << name << "::update() - Model does not match generated code\");" << std::endl;
+			cpp << "\t}" << std::endl;
+		}
+		
+		cpp << "}" << std::endl;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
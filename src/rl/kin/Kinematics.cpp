@@ -683,6 +683,14 @@ namespace rl
 			}
 		}
 		
+		bool
+		Kinematics::getWraparound(const ::std::size_t& i) const
+		{
+			assert(i < this->joints.size());
+			
+			return this->joints[i]->wraparound;
+		}
+		
 		void
 		Kinematics::getWraparounds(::Eigen::Matrix<bool, ::Eigen::Dynamic, 1>& wraparounds) const
 		{
@@ -127,7 +127,7 @@ namespace rl
 				nodeDegree(8),
 				nodeDegreeMax(12),
 				nodeDegreeMin(4),
-				root(first, last, nullptr, 0, 0, nodeDegree, nodeDataMax, true),
+				root(first, last, 0, 0, nodeDegree, nodeDataMax, true),
 				values(::std::distance(first, last))
 			{
 				if (this->root.data.size() > this->nodeDataMax && this->root.data.size() > this->root.degree)
@@ -215,6 +215,17 @@ namespace rl
 				return this->search(query, &k, nullptr, sorted);
 			}
 			
+			/**
+			 * Search for the k nearest neighbors of several queries.
+			 *
+			 * Queries are distributed across OpenMP threads if available, each
+			 * thread reusing its own search buffers for all of its queries.
+			 */
+			::std::vector<::std::vector<Neighbor>> nearest(const ::std::vector<Value>& queries, const ::std::size_t& k, const bool& sorted = true) const
+			{
+				return this->search(queries, &k, nullptr, sorted);
+			}
+			
 			void push(const Value& value)
 			{
 				this->push(this->root, value);
@@ -226,6 +237,16 @@ namespace rl
 				return this->search(query, nullptr, &radius, sorted);
 			}
 			
+			/**
+			 * Search for all neighbors within a radius of several queries.
+			 *
+			 * @see nearest(const ::std::vector<Value>&, const ::std::size_t&, const bool&) const
+			 */
+			::std::vector<::std::vector<Neighbor>> radius(const ::std::vector<Value>& queries, const Distance& radius, const bool& sorted = true) const
+			{
+				return this->search(queries, nullptr, &radius, sorted);
+			}
+			
 			void seed(const ::std::mt19937::result_type& value)
 			{
 				this->generator.seed(value);
@@ -370,6 +391,18 @@ namespace rl
 				bool removed;
 			};
 			
+			/**
+			 * Search buffers that are reused across node visits and queries.
+			 */
+			struct Workspace
+			{
+				::std::vector<Branch> branches;
+				
+				::std::vector<Distance> distances;
+				
+				::std::vector<bool> removed;
+			};
+			
 			void choose(const Node& node, ::std::vector<::std::size_t>& centers, ::std::vector<::std::vector<Distance>>& distances)
 			{
 				::std::size_t k = node.degree;
@@ -453,10 +486,44 @@ namespace rl
 			::std::vector<Neighbor> search(const Value& query, const ::std::size_t* k, const Distance* radius, const bool& sorted) const
 			{
 				::std::vector<Neighbor> neighbors;
+				Workspace workspace;
+				this->search(query, k, radius, sorted, workspace, neighbors);
+				return neighbors;
+			}
+			
+			::std::vector<::std::vector<Neighbor>> search(const ::std::vector<Value>& queries, const ::std::size_t* k, const Distance* radius, const bool& sorted) const
+			{
+				::std::vector<::std::vector<Neighbor>> neighbors(queries.size());
 				
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+				{
+					Workspace workspace;
+					
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#if _OPENMP < 200805
+					for (::std::ptrdiff_t i = 0; i < queries.size(); ++i)
+#else
+					for (::std::size_t i = 0; i < queries.size(); ++i)
+#endif
+#else
+					for (::std::size_t i = 0; i < queries.size(); ++i)
+#endif
+					{
+						this->search(queries[i], k, radius, sorted, workspace, neighbors[i]);
+					}
+				}
+				
+				return neighbors;
+			}
+			
+			void search(const Value& query, const ::std::size_t* k, const Distance* radius, const bool& sorted, Workspace& workspace, ::std::vector<Neighbor>& neighbors) const
+			{
 				if (this->empty())
 				{
-					return neighbors;
+					return;
 				}
 				
 				if (nullptr != k)
@@ -466,8 +533,9 @@ namespace rl
 				
 				::std::size_t checks = 0;
 				
-				::std::vector<Branch> branches;
-				this->search(this->root, query, k, radius, branches, neighbors, checks);
+				::std::vector<Branch>& branches = workspace.branches;
+				branches.clear();
+				this->search(this->root, query, k, radius, workspace, neighbors, checks);
 				
 				while (!branches.empty() && (!this->checks || checks < this->checks))
 				{
@@ -486,18 +554,16 @@ namespace rl
 						}
 					}
 					
-					this->search(*branch.second, query, k, radius, branches, neighbors, checks);
+					this->search(*branch.second, query, k, radius, workspace, neighbors, checks);
 				}
 				
 				if (sorted)
 				{
 					::std::sort_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
 				}
-				
-				return neighbors;
 			}
 			
-			void search(const Node& node, const Value& query, const ::std::size_t* k, const Distance* radius, ::std::vector<Branch>& branches, ::std::vector<Neighbor>& neighbors, ::std::size_t& checks) const
+			void search(const Node& node, const Value& query, const ::std::size_t* k, const Distance* radius, Workspace& workspace, ::std::vector<Neighbor>& neighbors, ::std::size_t& checks) const
 			{
 				if (node.children.empty())
 				{
@@ -528,8 +594,11 @@ namespace rl
 				}
 				else
 				{
-					::std::vector<Distance> distances(node.children.size());
-					::std::vector<bool> removed(node.children.size(), false);
+					::std::vector<Branch>& branches = workspace.branches;
+					::std::vector<Distance>& distances = workspace.distances;
+					distances.resize(node.children.size());
+					::std::vector<bool>& removed = workspace.removed;
+					removed.assign(node.children.size(), false);
 					
 					for (::std::size_t i = 0; i < node.children.size(); ++i)
 					{
@@ -24,7 +24,15 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
+#include <cmath>
+#include <rl/math/Rotation.h>
+#include <rl/math/TypeTraits.h>
+
 #include "AnalyticalInverseKinematics.h"
+#include "Exception.h"
+#include "Kinematic.h"
+#include "Revolute.h"
 
 namespace rl
 {
@@ -32,7 +40,10 @@ namespace rl
 	{
 		AnalyticalInverseKinematics::AnalyticalInverseKinematics(Kinematic* kinematic) :
 			InverseKinematics(kinematic),
-			solutions()
+			directions(),
+			points(),
+			solutions(),
+			zero(::rl::math::Transform::Identity())
 		{
 		}
 		
@@ -40,10 +51,202 @@ namespace rl
 		{
 		}
 		
+		void
+		AnalyticalInverseKinematics::addSolution(::rl::math::Vector& q, const ::rl::math::Vector& reference, const ::rl::math::Transform& goal)
+		{
+			::rl::math::Vector min = this->kinematic->getMinimum();
+			::rl::math::Vector max = this->kinematic->getMaximum();
+			
+			for (::std::ptrdiff_t i = 0; i < q.size(); ++i)
+			{
+				q(i) += 2 * ::rl::math::TypeTraits<::rl::math::Real>::pi * ::std::round((reference(i) - q(i)) / (2 * ::rl::math::TypeTraits<::rl::math::Real>::pi));
+				
+				if (q(i) < min(i))
+				{
+					q(i) += 2 * ::rl::math::TypeTraits<::rl::math::Real>::pi;
+				}
+				else if (q(i) > max(i))
+				{
+					q(i) -= 2 * ::rl::math::TypeTraits<::rl::math::Real>::pi;
+				}
+			}
+			
+			if (!this->kinematic->isValid(q))
+			{
+				return;
+			}
+			
+			this->kinematic->setPosition(q);
+			this->kinematic->forwardPosition();
+			
+			if (this->kinematic->getOperationalPosition(0).toDelta(goal).squaredNorm() > static_cast<::rl::math::Real>(1.0e-12))
+			{
+				return;
+			}
+			
+			for (::std::size_t i = 0; i < this->solutions.size(); ++i)
+			{
+				if ((this->solutions[i] - q).squaredNorm() < static_cast<::rl::math::Real>(1.0e-12))
+				{
+					return;
+				}
+			}
+			
+			this->solutions.push_back(q);
+		}
+		
+		::rl::math::Real
+		AnalyticalInverseKinematics::calculateAngle(const ::rl::math::Vector3& axis, const ::rl::math::Vector3& x, const ::rl::math::Vector3& y)
+		{
+			::rl::math::Vector3 x2 = x - axis * axis.dot(x);
+			::rl::math::Vector3 y2 = y - axis * axis.dot(y);
+			return ::std::atan2(axis.dot(x2.cross(y2)), x2.dot(y2));
+		}
+		
+		::std::size_t
+		AnalyticalInverseKinematics::calculateAngles(const ::rl::math::Real& a, const ::rl::math::Real& b, const ::rl::math::Real& c, ::rl::math::Real theta[2])
+		{
+			::rl::math::Real r = ::std::sqrt(a * a + b * b);
+			
+			if (r < static_cast<::rl::math::Real>(1.0e-12))
+			{
+				return 0;
+			}
+			
+			::rl::math::Real ratio = c / r;
+			
+			// tolerate rounding errors at the boundary of the workspace
+			if (::std::abs(ratio) > 1 + static_cast<::rl::math::Real>(1.0e-9))
+			{
+				return 0;
+			}
+			
+			::rl::math::Real phi = ::std::atan2(b, a);
+			::rl::math::Real delta = ::std::acos(::std::max<::rl::math::Real>(-1, ::std::min<::rl::math::Real>(1, ratio)));
+			
+			theta[0] = phi + delta;
+			theta[1] = phi - delta;
+			
+			return delta > 0 ? 2 : 1;
+		}
+		
+		::rl::math::Vector3
+		AnalyticalInverseKinematics::calculateIntersection(const ::std::size_t& i, const ::std::size_t& j) const
+		{
+			::rl::math::Vector3 n = this->directions[i].cross(this->directions[j]);
+			::rl::math::Real t = (this->points[j] - this->points[i]).cross(this->directions[j]).dot(n) / n.squaredNorm();
+			return this->points[i] + t * this->directions[i];
+		}
+		
+		::std::size_t
+		AnalyticalInverseKinematics::calculatePlanar(const ::std::size_t& i, const ::rl::math::Vector3& x, const ::rl::math::Vector3& y, ::rl::math::Real theta[2][2]) const
+		{
+			const ::rl::math::Vector3& u = this->directions[i];
+			
+			// projections onto the plane of motion
+			::rl::math::Vector3 a = this->points[i + 1] - this->points[i];
+			a -= u * u.dot(a);
+			::rl::math::Vector3 b = x - this->points[i + 1];
+			b -= u * u.dot(b);
+			::rl::math::Vector3 w = y - this->points[i];
+			w -= u * u.dot(w);
+			::rl::math::Vector3 ub = u.cross(b);
+			
+			// |a + R(theta) b| = |w|
+			::rl::math::Real t[2];
+			::std::size_t n = calculateAngles(a.dot(b), a.dot(ub), (w.squaredNorm() - a.squaredNorm() - b.squaredNorm()) / 2, t);
+			
+			for (::std::size_t k = 0; k < n; ++k)
+			{
+				::rl::math::Vector3 v = a + ::std::cos(t[k]) * b + ::std::sin(t[k]) * ub;
+				theta[k][0] = calculateAngle(u, v, w);
+				theta[k][1] = this->directions[i + 1].dot(u) > 0 ? t[k] : -t[k];
+			}
+			
+			return n;
+		}
+		
+		::rl::math::Transform
+		AnalyticalInverseKinematics::calculateRotation(const ::std::size_t& i, const ::rl::math::Real& theta) const
+		{
+			::rl::math::Transform t;
+			t.linear() = ::rl::math::AngleAxis(theta, this->directions[i]).toRotationMatrix();
+			t.translation() = this->points[i] - t.linear() * this->points[i];
+			return t;
+		}
+		
+		::rl::math::Real
+		AnalyticalInverseKinematics::distance(const ::std::size_t& i, const ::rl::math::Vector3& x) const
+		{
+			return (x - this->points[i]).cross(this->directions[i]).norm();
+		}
+		
+		bool
+		AnalyticalInverseKinematics::finish(const ::rl::math::Vector& reference)
+		{
+			::std::sort(
+				this->solutions.begin(),
+				this->solutions.end(),
+				[&](const ::rl::math::Vector& a, const ::rl::math::Vector& b) {
+					return this->kinematic->transformedDistance(reference, a) < this->kinematic->transformedDistance(reference, b);
+				}
+			);
+			
+			this->kinematic->setPosition(this->solutions.empty() ? reference : this->solutions.front());
+			
+			return !this->solutions.empty();
+		}
+		
 		const ::std::vector<::rl::math::Vector>&
 		AnalyticalInverseKinematics::getSolutions() const
 		{
 			return this->solutions;
 		}
+		
+		void
+		AnalyticalInverseKinematics::updateAxes()
+		{
+			if (1 != this->kinematic->getOperationalDof())
+			{
+				throw Exception("rl::mdl::AnalyticalInverseKinematics::updateAxes() - Model with more than one operational frame");
+			}
+			
+			for (::std::size_t i = 0; i < this->kinematic->getJoints(); ++i)
+			{
+				if (nullptr == dynamic_cast<Revolute*>(this->kinematic->getJoint(i)))
+				{
+					throw Exception("rl::mdl::AnalyticalInverseKinematics::updateAxes() - Model with other than revolute joints");
+				}
+			}
+			
+			::rl::math::Vector q = this->kinematic->getPosition();
+			
+			this->kinematic->setPosition(::rl::math::Vector::Zero(this->kinematic->getDofPosition()));
+			this->kinematic->forwardPosition();
+			
+			::rl::math::Matrix J(6, this->kinematic->getDof());
+			this->kinematic->calculateJacobian(J, true);
+			
+			this->zero = this->kinematic->getOperationalPosition(0);
+			this->directions.resize(this->kinematic->getDof());
+			this->points.resize(this->kinematic->getDof());
+			
+			for (::std::size_t i = 0; i < this->kinematic->getDof(); ++i)
+			{
+				// column is angular velocity and velocity of operational frame origin
+				::rl::math::Real norm = J.block<3, 1>(3, i).norm();
+				
+				if (norm < static_cast<::rl::math::Real>(1.0e-9))
+				{
+					throw Exception("rl::mdl::AnalyticalInverseKinematics::updateAxes() - Joint does not move operational frame");
+				}
+				
+				this->directions[i] = J.block<3, 1>(3, i) / norm;
+				this->points[i] = this->zero.translation() + this->directions[i].cross(J.block<3, 1>(0, i) / norm);
+			}
+			
+			this->kinematic->setPosition(q);
+			this->kinematic->forwardPosition();
+		}
 	}
 }
@@ -27,24 +27,112 @@
 #ifndef RL_MDL_ANALYTICALINVERSEKINEMATICS_H
 #define RL_MDL_ANALYTICALINVERSEKINEMATICS_H
 
+#include <rl/math/Transform.h>
+#include <rl/math/Vector.h>
+
 #include "InverseKinematics.h"
 
 namespace rl
 {
 	namespace mdl
 	{
+		/**
+		 * Closed-form inverse kinematics returning all solution branches.
+		 *
+		 * Derived classes solve for a chain of revolute joints described by the
+		 * joint axes of the kinematic model in its zero configuration, using
+		 * the product of exponentials formulation
+		 * \f[ {}^{0}T_{n}(\vec{q}) = e^{\hat{\xi}_{1} q_{1}} \cdots e^{\hat{\xi}_{n} q_{n}} \, {}^{0}T_{n}(\vec{0}) \f]
+		 * and the subproblems of Paden and Kahan.
+		 *
+		 * Richard M. Murray, Zexiang Li, and S. Shankar Sastry. A Mathematical
+		 * Introduction to Robotic Manipulation. CRC Press, 1994.
+		 */
 		class RL_MDL_EXPORT AnalyticalInverseKinematics : public InverseKinematics
 		{
 		public:
+			EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+			
 			AnalyticalInverseKinematics(Kinematic* kinematic);
 			
 			virtual ~AnalyticalInverseKinematics();
 			
+			/**
+			 * Solutions of the last call to solve(), sorted by distance to the
+			 * configuration at the start of solve().
+			 */
 			const ::std::vector<::rl::math::Vector>& getSolutions() const;
 			
 		protected:
+			/**
+			 * Add a candidate solution.
+			 *
+			 * Revolute joints are shifted by multiples of \f$2 \pi\f$ towards the
+			 * reference configuration within their limits. Candidates outside the
+			 * limits, missing the goal or duplicating a previous solution are
+			 * discarded.
+			 */
+			void addSolution(::rl::math::Vector& q, const ::rl::math::Vector& reference, const ::rl::math::Transform& goal);
+			
+			/**
+			 * Angle of rotation about a unit axis that moves x onto y.
+			 */
+			static ::rl::math::Real calculateAngle(const ::rl::math::Vector3& axis, const ::rl::math::Vector3& x, const ::rl::math::Vector3& y);
+			
+			/**
+			 * Solutions of \f$a \cos \theta + b \sin \theta = c\f$.
+			 *
+			 * @return Number of solutions
+			 */
+			static ::std::size_t calculateAngles(const ::rl::math::Real& a, const ::rl::math::Real& b, const ::rl::math::Real& c, ::rl::math::Real theta[2]);
+			
+			/**
+			 * Closest point of axis i and axis j, which are not parallel.
+			 */
+			::rl::math::Vector3 calculateIntersection(const ::std::size_t& i, const ::std::size_t& j) const;
+			
+			/**
+			 * Rotations about the parallel axes i and i + 1 that move point x onto y.
+			 *
+			 * @return Number of solutions
+			 */
+			::std::size_t calculatePlanar(const ::std::size_t& i, const ::rl::math::Vector3& x, const ::rl::math::Vector3& y, ::rl::math::Real theta[2][2]) const;
+			
+			/**
+			 * Rigid body motion \f$e^{\hat{\xi}_{i} \theta}\f$ of rotation about axis i.
+			 */
+			::rl::math::Transform calculateRotation(const ::std::size_t& i, const ::rl::math::Real& theta) const;
+			
+			/**
+			 * Distance of point x to axis i.
+			 */
+			::rl::math::Real distance(const ::std::size_t& i, const ::rl::math::Vector3& x) const;
+			
+			/**
+			 * Sort solutions and set the closest one as position of the kinematic
+			 * model.
+			 */
+			bool finish(const ::rl::math::Vector& reference);
+			
+			/**
+			 * Extract joint axes and operational frame in zero configuration.
+			 *
+			 * @throws Exception If the model has other than revolute joints or more
+			 * than one operational frame
+			 */
+			void updateAxes();
+			
+			/** Unit directions of joint axes in zero configuration. */
+			::std::vector<::rl::math::Vector3> directions;
+			
+			/** Points on joint axes in zero configuration. */
+			::std::vector<::rl::math::Vector3> points;
+			
 			::std::vector<::rl::math::Vector> solutions;
 			
+			/** Operational frame in zero configuration. */
+			::rl::math::Transform zero;
+			
 		private:
 			
 		};
@@ -0,0 +1,228 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <atomic>
+
+#include "BatchSimulator.h"
+#include "Dynamic.h"
+#include "Exception.h"
+#include "Integrator.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		BatchSimulator::BatchSimulator(const ::std::size_t& threads) :
+			threads(threads),
+			dynamics(),
+			integrators(),
+			pool(),
+			positions(),
+			steps(0),
+			torqueFunctions(),
+			torques(),
+			velocities()
+		{
+		}
+		
+		BatchSimulator::~BatchSimulator()
+		{
+		}
+		
+		::std::size_t
+		BatchSimulator::add(const ::std::shared_ptr<Dynamic>& dynamic, const ::std::shared_ptr<Integrator>& integrator, const TorqueFunction& torque)
+		{
+			if (nullptr == dynamic || nullptr == integrator || integrator->getDynamic() != dynamic.get())
+			{
+				throw Exception("rl::mdl::BatchSimulator::add() - Integrator does not operate on dynamic model");
+			}
+			
+			if (!this->dynamics.empty() && (dynamic->getDofPosition() != this->dynamics.front()->getDofPosition() || dynamic->getDof() != this->dynamics.front()->getDof()))
+			{
+				throw Exception("rl::mdl::BatchSimulator::add() - Degrees of freedom do not match previous instances");
+			}
+			
+			for (::std::size_t i = 0; i < this->dynamics.size(); ++i)
+			{
+				if (dynamic == this->dynamics[i])
+				{
+					throw Exception("rl::mdl::BatchSimulator::add() - Dynamic model already used by another instance");
+				}
+			}
+			
+			this->dynamics.push_back(dynamic);
+			this->integrators.push_back(integrator);
+			this->torqueFunctions.push_back(torque);
+			
+			return this->dynamics.size() - 1;
+		}
+		
+		void
+		BatchSimulator::clear()
+		{
+			this->dynamics.clear();
+			this->integrators.clear();
+			this->positions.resize(0, 0);
+			this->steps = 0;
+			this->torqueFunctions.clear();
+			this->torques.resize(0, 0);
+			this->velocities.resize(0, 0);
+		}
+		
+		Dynamic*
+		BatchSimulator::getDynamic(const ::std::size_t& i) const
+		{
+			return this->dynamics[i].get();
+		}
+		
+		Integrator*
+		BatchSimulator::getIntegrator(const ::std::size_t& i) const
+		{
+			return this->integrators[i].get();
+		}
+		
+		::std::size_t
+		BatchSimulator::getNumInstances() const
+		{
+			return this->dynamics.size();
+		}
+		
+		::Eigen::Map<const ::rl::math::Vector>
+		BatchSimulator::getPosition(const ::std::size_t& i, const ::std::size_t& k) const
+		{
+			::std::size_t n = this->dynamics[i]->getDofPosition();
+			return ::Eigen::Map<const ::rl::math::Vector>(this->positions.col(i).data() + k * n, n);
+		}
+		
+		const ::rl::math::Matrix&
+		BatchSimulator::getPositions() const
+		{
+			return this->positions;
+		}
+		
+		::std::size_t
+		BatchSimulator::getSteps() const
+		{
+			return this->steps;
+		}
+		
+		::Eigen::Map<const ::rl::math::Vector>
+		BatchSimulator::getTorque(const ::std::size_t& i, const ::std::size_t& k) const
+		{
+			::std::size_t n = this->dynamics[i]->getDof();
+			return ::Eigen::Map<const ::rl::math::Vector>(this->torques.col(i).data() + k * n, n);
+		}
+		
+		const ::rl::math::Matrix&
+		BatchSimulator::getTorques() const
+		{
+			return this->torques;
+		}
+		
+		::Eigen::Map<const ::rl::math::Vector>
+		BatchSimulator::getVelocity(const ::std::size_t& i, const ::std::size_t& k) const
+		{
+			::std::size_t n = this->dynamics[i]->getDof();
+			return ::Eigen::Map<const ::rl::math::Vector>(this->velocities.col(i).data() + k * n, n);
+		}
+		
+		const ::rl::math::Matrix&
+		BatchSimulator::getVelocities() const
+		{
+			return this->velocities;
+		}
+		
+		void
+		BatchSimulator::setTorqueFunction(const ::std::size_t& i, const TorqueFunction& torque)
+		{
+			this->torqueFunctions[i] = torque;
+		}
+		
+		void
+		BatchSimulator::simulate(const ::rl::math::Real& dt, const ::std::size_t& steps, const ::rl::math::Real& t0)
+		{
+			::std::size_t n = this->dynamics.size();
+			
+			if (0 == n)
+			{
+				return;
+			}
+			
+			::std::size_t dof = this->dynamics.front()->getDof();
+			::std::size_t dofPosition = this->dynamics.front()->getDofPosition();
+			
+			this->positions.resize((steps + 1) * dofPosition, n);
+			this->steps = steps;
+			this->torques.resize(steps * dof, n);
+			this->velocities.resize((steps + 1) * dof, n);
+			
+			::std::size_t size = ::std::min(::std::max<::std::size_t>(this->threads, 1), n);
+			
+			if (nullptr == this->pool || this->pool->size() != size)
+			{
+				this->pool.reset(new ::rl::util::thread_pool(size));
+			}
+			
+			::std::atomic<::std::size_t> next(0);
+			
+			this->pool->run([&](const ::std::size_t&) {
+				::rl::math::Vector q(dofPosition);
+				::rl::math::Vector qd(dof);
+				::rl::math::Vector tau(dof);
+				
+				for (::std::size_t i = next++; i < n; i = next++)
+				{
+					Dynamic* dynamic = this->dynamics[i].get();
+					Integrator* integrator = this->integrators[i].get();
+					const TorqueFunction& torque = this->torqueFunctions[i];
+					
+					dynamic->getPosition(q);
+					dynamic->getVelocity(qd);
+					this->positions.col(i).head(dofPosition) = q;
+					this->velocities.col(i).head(dof) = qd;
+					
+					for (::std::size_t k = 0; k < steps; ++k)
+					{
+						if (torque)
+						{
+							torque(t0 + k * dt, dynamic);
+						}
+						
+						dynamic->getTorque(tau);
+						this->torques.col(i).segment(k * dof, dof) = tau;
+						
+						integrator->integrate(dt);
+						
+						dynamic->getPosition(q);
+						dynamic->getVelocity(qd);
+						this->positions.col(i).segment((k + 1) * dofPosition, dofPosition) = q;
+						this->velocities.col(i).segment((k + 1) * dof, dof) = qd;
+					}
+				}
+			});
+		}
+	}
+}
@@ -0,0 +1,183 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_MDL_BATCHSIMULATOR_H
+#define RL_MDL_BATCHSIMULATOR_H
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <rl/math/Matrix.h>
+#include <rl/math/Real.h>
+#include <rl/math/Vector.h>
+#include <rl/mdl/export.h>
+#include <rl/util/thread_pool.h>
+
+namespace rl
+{
+	namespace mdl
+	{
+		class Dynamic;
+		class Integrator;
+		
+		/**
+		 * Parallel simulation of many independent dynamic models.
+		 *
+		 * Every instance consists of a separate Dynamic model, an Integrator
+		 * operating on it and an optional torque function. simulate() distributes
+		 * the instances over a pool of threads and integrates each of them for a
+		 * fixed number of steps, e.g., for Monte-Carlo rollouts with perturbed
+		 * model parameters.
+		 *
+		 * Trajectories are stored in structure-of-arrays layout with one column
+		 * per instance. Step \f$k\f$ of instance \f$i\f$ occupies rows
+		 * \f$[k \, n, (k + 1) \, n)\f$ of column \f$i\f$, with \f$n\f$ the number
+		 * of position or velocity coordinates. The buffers are only reallocated
+		 * if the number of instances or steps changes.
+		 *
+		 * All instances must have the same degrees of freedom.
+		 */
+		class RL_MDL_EXPORT BatchSimulator
+		{
+		public:
+			/**
+			 * Called before every integration step with the current time and
+			 * the model of an instance, which should update the torque via
+			 * Dynamic::setTorque(). It is called from a worker thread and may only
+			 * access the model it is given.
+			 */
+			typedef ::std::function<void(const ::rl::math::Real&, Dynamic*)> TorqueFunction;
+			
+			explicit BatchSimulator(const ::std::size_t& threads = ::std::thread::hardware_concurrency());
+			
+			virtual ~BatchSimulator();
+			
+			/**
+			 * Add an instance.
+			 *
+			 * @param[in] dynamic Model of this instance, not shared with other instances
+			 * @param[in] integrator Integrator operating on dynamic
+			 * @param[in] torque Torque function, keeps the current torque if empty
+			 * @return Index of the new instance
+			 */
+			::std::size_t add(const ::std::shared_ptr<Dynamic>& dynamic, const ::std::shared_ptr<Integrator>& integrator, const TorqueFunction& torque = TorqueFunction());
+			
+			void clear();
+			
+			Dynamic* getDynamic(const ::std::size_t& i) const;
+			
+			Integrator* getIntegrator(const ::std::size_t& i) const;
+			
+			::std::size_t getNumInstances() const;
+			
+			/**
+			 * Joint positions of instance i at step k.
+			 *
+			 * @pre simulate()
+			 * @pre 0 <= k <= getSteps()
+			 */
+			::Eigen::Map<const ::rl::math::Vector> getPosition(const ::std::size_t& i, const ::std::size_t& k) const;
+			
+			/**
+			 * Joint positions of all instances and steps.
+			 *
+			 * @pre simulate()
+			 */
+			const ::rl::math::Matrix& getPositions() const;
+			
+			::std::size_t getSteps() const;
+			
+			/**
+			 * Joint torques of instance i applied during step k.
+			 *
+			 * @pre simulate()
+			 * @pre 0 <= k < getSteps()
+			 */
+			::Eigen::Map<const ::rl::math::Vector> getTorque(const ::std::size_t& i, const ::std::size_t& k) const;
+			
+			/**
+			 * Joint torques of all instances and steps.
+			 *
+			 * @pre simulate()
+			 */
+			const ::rl::math::Matrix& getTorques() const;
+			
+			/**
+			 * Joint velocities of instance i at step k.
+			 *
+			 * @pre simulate()
+			 * @pre 0 <= k <= getSteps()
+			 */
+			::Eigen::Map<const ::rl::math::Vector> getVelocity(const ::std::size_t& i, const ::std::size_t& k) const;
+			
+			/**
+			 * Joint velocities of all instances and steps.
+			 *
+			 * @pre simulate()
+			 */
+			const ::rl::math::Matrix& getVelocities() const;
+			
+			void setTorqueFunction(const ::std::size_t& i, const TorqueFunction& torque);
+			
+			/**
+			 * Integrate all instances from their current state.
+			 *
+			 * Positions and velocities are recorded before the first and after
+			 * every step, the torques for every step.
+			 *
+			 * @param[in] dt Integration time step \f$\Delta t\f$
+			 * @param[in] steps Number of integration steps
+			 * @param[in] t0 Time passed to the torque functions in the first step
+			 */
+			void simulate(const ::rl::math::Real& dt, const ::std::size_t& steps, const ::rl::math::Real& t0 = 0);
+			
+			/** Number of threads for simulating instances. */
+			::std::size_t threads;
+			
+		protected:
+			
+		private:
+			::std::vector<::std::shared_ptr<Dynamic>> dynamics;
+			
+			::std::vector<::std::shared_ptr<Integrator>> integrators;
+			
+			::std::unique_ptr<::rl::util::thread_pool> pool;
+			
+			::rl::math::Matrix positions;
+			
+			::std::size_t steps;
+			
+			::std::vector<TorqueFunction> torqueFunctions;
+			
+			::rl::math::Matrix torques;
+			
+			::rl::math::Matrix velocities;
+		};
+	}
+}
+
+#endif // RL_MDL_BATCHSIMULATOR_H
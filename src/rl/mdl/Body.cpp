@@ -47,6 +47,12 @@ namespace rl
 		{
 		}
 		
+		Body*
+		Body::clone() const
+		{
+			return new Body(*this);
+		}
+		
 		void
 		Body::forwardAcceleration()
 		{
@@ -42,6 +42,8 @@ namespace rl
 			
 			virtual ~Body();
 			
+			Body* clone() const;
+			
 			void forwardAcceleration();
 			
 			void forwardDynamics1();
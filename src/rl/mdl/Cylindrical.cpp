@@ -53,6 +53,24 @@ namespace rl
 		{
 		}
 		
+		void
+		Cylindrical::calculateBatch(const ::rl::math::ConstMatrixRef& q, Batch& x) const
+		{
+			x.resize(12, q.cols());
+			Joint::setBatchRotation(this->S.block<3, 1>(0, 0), q.row(0).array() + this->offset(0), x);
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				x.row(9 + i) = this->S(3 + i, 1) * (q.row(1).array() + this->offset(1));
+			}
+		}
+		
+		Cylindrical*
+		Cylindrical::clone() const
+		{
+			return new Cylindrical(*this);
+		}
+		
 		void
 		Cylindrical::setPosition(const ::rl::math::ConstVectorRef& q)
 		{
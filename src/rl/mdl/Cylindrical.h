@@ -40,6 +40,10 @@ namespace rl
 			
 			virtual ~Cylindrical();
 			
+			void calculateBatch(const ::rl::math::ConstMatrixRef& q, Batch& x) const;
+			
+			Cylindrical* clone() const;
+			
 			void setPosition(const ::rl::math::ConstVectorRef& q);
 			
 		protected:
@@ -0,0 +1,334 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "Dynamic.h"
+#include "DormandPrinceIntegrator.h"
+#include "Exception.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		namespace
+		{
+			const ::rl::math::Real a[7][6] = {
+				{ 0, 0, 0, 0, 0, 0 },
+				{ static_cast<::rl::math::Real>(1) / 5, 0, 0, 0, 0, 0 },
+				{ static_cast<::rl::math::Real>(3) / 40, static_cast<::rl::math::Real>(9) / 40, 0, 0, 0, 0 },
+				{ static_cast<::rl::math::Real>(44) / 45, static_cast<::rl::math::Real>(-56) / 15, static_cast<::rl::math::Real>(32) / 9, 0, 0, 0 },
+				{ static_cast<::rl::math::Real>(19372) / 6561, static_cast<::rl::math::Real>(-25360) / 2187, static_cast<::rl::math::Real>(64448) / 6561, static_cast<::rl::math::Real>(-212) / 729, 0, 0 },
+				{ static_cast<::rl::math::Real>(9017) / 3168, static_cast<::rl::math::Real>(-355) / 33, static_cast<::rl::math::Real>(46732) / 5247, static_cast<::rl::math::Real>(49) / 176, static_cast<::rl::math::Real>(-5103) / 18656, 0 },
+				{ static_cast<::rl::math::Real>(35) / 384, 0, static_cast<::rl::math::Real>(500) / 1113, static_cast<::rl::math::Real>(125) / 192, static_cast<::rl::math::Real>(-2187) / 6784, static_cast<::rl::math::Real>(11) / 84 }
+			};
+			
+			/** Coefficients of continuous extension. */
+			const ::rl::math::Real d[7] = {
+				static_cast<::rl::math::Real>(-12715105075.0 / 11282082432.0),
+				0,
+				static_cast<::rl::math::Real>(87487479700.0 / 32700410799.0),
+				static_cast<::rl::math::Real>(-10690763975.0 / 1880347072.0),
+				static_cast<::rl::math::Real>(701980252875.0 / 199316789632.0),
+				static_cast<::rl::math::Real>(-1453857185.0 / 822651844.0),
+				static_cast<::rl::math::Real>(69997945.0 / 29380423.0)
+			};
+			
+			/** Difference between fifth and fourth order weights. */
+			const ::rl::math::Real e[7] = {
+				static_cast<::rl::math::Real>(71) / 57600,
+				0,
+				static_cast<::rl::math::Real>(-71) / 16695,
+				static_cast<::rl::math::Real>(71) / 1920,
+				static_cast<::rl::math::Real>(-17253) / 339200,
+				static_cast<::rl::math::Real>(22) / 525,
+				static_cast<::rl::math::Real>(-1) / 40
+			};
+		}
+		
+		DormandPrinceIntegrator::DormandPrinceIntegrator(Dynamic* dynamic) :
+			Integrator(dynamic),
+			absoluteTolerance(static_cast<::rl::math::Real>(1.0e-6)),
+			acceptedSteps(0),
+			continuousPosition(),
+			continuousVelocity(),
+			kAcceleration(),
+			kVelocity(),
+			minimumStep(static_cast<::rl::math::Real>(1.0e-12)),
+			q(),
+			q0(),
+			q1(),
+			qd(),
+			qd0(),
+			qd1(),
+			qdd(),
+			qdd0(),
+			rejectedSteps(0),
+			relativeTolerance(static_cast<::rl::math::Real>(1.0e-6)),
+			step(0),
+			times()
+		{
+		}
+		
+		DormandPrinceIntegrator::~DormandPrinceIntegrator()
+		{
+		}
+		
+		const ::rl::math::Real&
+		DormandPrinceIntegrator::getAbsoluteTolerance() const
+		{
+			return this->absoluteTolerance;
+		}
+		
+		const ::std::size_t&
+		DormandPrinceIntegrator::getAcceptedSteps() const
+		{
+			return this->acceptedSteps;
+		}
+		
+		const ::rl::math::Real&
+		DormandPrinceIntegrator::getMinimumStep() const
+		{
+			return this->minimumStep;
+		}
+		
+		const ::std::size_t&
+		DormandPrinceIntegrator::getRejectedSteps() const
+		{
+			return this->rejectedSteps;
+		}
+		
+		const ::rl::math::Real&
+		DormandPrinceIntegrator::getRelativeTolerance() const
+		{
+			return this->relativeTolerance;
+		}
+		
+		const ::rl::math::Real&
+		DormandPrinceIntegrator::getStep() const
+		{
+			return this->step;
+		}
+		
+		void
+		DormandPrinceIntegrator::integrate(const ::rl::math::Real& dt)
+		{
+			if (this->dynamic->getDofPosition() != this->dynamic->getDof())
+			{
+				throw Exception("rl::mdl::DormandPrinceIntegrator::integrate() - Position and velocity coordinates differ in size");
+			}
+			
+			::std::size_t n = this->dynamic->getDof();
+			
+			this->resize(n);
+			
+			this->acceptedSteps = 0;
+			this->rejectedSteps = 0;
+			this->times.clear();
+			this->times.push_back(0);
+			
+			this->dynamic->getPosition(this->q0);
+			this->dynamic->getVelocity(this->qd0);
+			
+			this->dynamic->forwardDynamics();
+			this->dynamic->getAcceleration(this->qdd0);
+			
+			this->kVelocity.col(0) = this->qd0;
+			this->kAcceleration.col(0) = this->qdd0;
+			
+			::rl::math::Real t = 0;
+			::rl::math::Real h = this->step > 0 ? this->step : dt;
+			bool rejected = false;
+			
+			while (t < dt)
+			{
+				// avoid a tiny remainder before the end of the interval
+				bool last = t + static_cast<::rl::math::Real>(1.01) * h >= dt;
+				
+				if (last)
+				{
+					h = dt - t;
+				}
+				
+				if (!last && h < this->minimumStep)
+				{
+					throw Exception("rl::mdl::DormandPrinceIntegrator::integrate() - Step size below minimum");
+				}
+				
+				for (::std::size_t i = 1; i < 7; ++i)
+				{
+					::Eigen::Map<const ::rl::math::Vector> ai(a[i], i);
+					this->q = this->q0;
+					this->q.noalias() += h * this->kVelocity.leftCols(i) * ai;
+					this->qd = this->qd0;
+					this->qd.noalias() += h * this->kAcceleration.leftCols(i) * ai;
+					
+					this->dynamic->setPosition(this->q);
+					this->dynamic->setVelocity(this->qd);
+					this->dynamic->forwardDynamics();
+					this->dynamic->getAcceleration(this->qdd);
+					
+					this->kVelocity.col(i) = this->qd;
+					this->kAcceleration.col(i) = this->qdd;
+				}
+				
+				// last stage is evaluated at the fifth order solution
+				this->q1 = this->q;
+				this->qd1 = this->qd;
+				
+				::Eigen::Map<const ::rl::math::Vector> ei(e, 7);
+				this->q.noalias() = h * this->kVelocity * ei;
+				this->qd.noalias() = h * this->kAcceleration * ei;
+				
+				::rl::math::Real error = 0;
+				
+				for (::std::size_t j = 0; j < n; ++j)
+				{
+					error += ::std::pow(this->q(j) / (this->absoluteTolerance + this->relativeTolerance * ::std::max(::std::abs(this->q0(j)), ::std::abs(this->q1(j)))), 2);
+					error += ::std::pow(this->qd(j) / (this->absoluteTolerance + this->relativeTolerance * ::std::max(::std::abs(this->qd0(j)), ::std::abs(this->qd1(j)))), 2);
+				}
+				
+				error = ::std::sqrt(error / (2 * n));
+				
+				// step size control with safety factor and bounded change
+				::rl::math::Real factor = error > 0 ? static_cast<::rl::math::Real>(0.9) * ::std::pow(error, static_cast<::rl::math::Real>(-0.2)) : 5;
+				factor = ::std::max<::rl::math::Real>(static_cast<::rl::math::Real>(0.2), ::std::min<::rl::math::Real>(rejected ? 1 : 5, factor));
+				
+				if (error > 1 || !::std::isfinite(error))
+				{
+					++this->rejectedSteps;
+					rejected = true;
+					h *= ::std::isfinite(error) ? factor : static_cast<::rl::math::Real>(0.2);
+					continue;
+				}
+				
+				::std::size_t k = 5 * this->acceptedSteps;
+				
+				if (static_cast<::std::size_t>(this->continuousPosition.cols()) < k + 5)
+				{
+					this->continuousPosition.conservativeResize(n, 2 * (k + 5));
+					this->continuousVelocity.conservativeResize(n, 2 * (k + 5));
+				}
+				
+				::Eigen::Map<const ::rl::math::Vector> di(d, 7);
+				
+				this->continuousPosition.col(k) = this->q0;
+				this->continuousPosition.col(k + 1) = this->q1 - this->q0;
+				this->continuousPosition.col(k + 2) = h * this->kVelocity.col(0) - this->continuousPosition.col(k + 1);
+				this->continuousPosition.col(k + 3) = this->continuousPosition.col(k + 1) - h * this->kVelocity.col(6) - this->continuousPosition.col(k + 2);
+				this->continuousPosition.col(k + 4).noalias() = h * this->kVelocity * di;
+				
+				this->continuousVelocity.col(k) = this->qd0;
+				this->continuousVelocity.col(k + 1) = this->qd1 - this->qd0;
+				this->continuousVelocity.col(k + 2) = h * this->kAcceleration.col(0) - this->continuousVelocity.col(k + 1);
+				this->continuousVelocity.col(k + 3) = this->continuousVelocity.col(k + 1) - h * this->kAcceleration.col(6) - this->continuousVelocity.col(k + 2);
+				this->continuousVelocity.col(k + 4).noalias() = h * this->kAcceleration * di;
+				
+				++this->acceptedSteps;
+				t = last ? dt : t + h;
+				this->times.push_back(t);
+				
+				this->q0 = this->q1;
+				this->qd0 = this->qd1;
+				
+				// first same as last
+				this->kVelocity.col(0) = this->kVelocity.col(6);
+				this->kAcceleration.col(0) = this->kAcceleration.col(6);
+				
+				// shortened last step does not limit the estimate
+				this->step = last ? ::std::max(this->step, h * factor) : h * factor;
+				h = this->step;
+				rejected = false;
+			}
+			
+			this->dynamic->setPosition(this->q0);
+			this->dynamic->setVelocity(this->qd0);
+			this->dynamic->setAcceleration(this->qdd0);
+		}
+		
+		void
+		DormandPrinceIntegrator::interpolate(const ::rl::math::Real& t, ::rl::math::Vector& q, ::rl::math::Vector& qd) const
+		{
+			assert(this->acceptedSteps > 0);
+			
+			::std::size_t i = ::std::upper_bound(this->times.begin() + 1, this->times.begin() + this->acceptedSteps, t) - this->times.begin() - 1;
+			::std::size_t k = 5 * i;
+			::rl::math::Real theta = (t - this->times[i]) / (this->times[i + 1] - this->times[i]);
+			::rl::math::Real theta1 = 1 - theta;
+			
+			q = this->continuousPosition.col(k) + theta * (this->continuousPosition.col(k + 1) + theta1 * (this->continuousPosition.col(k + 2) + theta * (this->continuousPosition.col(k + 3) + theta1 * this->continuousPosition.col(k + 4))));
+			qd = this->continuousVelocity.col(k) + theta * (this->continuousVelocity.col(k + 1) + theta1 * (this->continuousVelocity.col(k + 2) + theta * (this->continuousVelocity.col(k + 3) + theta1 * this->continuousVelocity.col(k + 4))));
+		}
+		
+		void
+		DormandPrinceIntegrator::resize(const ::std::size_t& n)
+		{
+			if (static_cast<::std::size_t>(this->q.size()) == n)
+			{
+				return;
+			}
+			
+			this->continuousPosition.resize(n, 0);
+			this->continuousVelocity.resize(n, 0);
+			this->kAcceleration.resize(n, 7);
+			this->kVelocity.resize(n, 7);
+			this->q.resize(n);
+			this->q0.resize(n);
+			this->q1.resize(n);
+			this->qd.resize(n);
+			this->qd0.resize(n);
+			this->qd1.resize(n);
+			this->qdd.resize(n);
+			this->qdd0.resize(n);
+		}
+		
+		void
+		DormandPrinceIntegrator::setAbsoluteTolerance(const ::rl::math::Real& absoluteTolerance)
+		{
+			this->absoluteTolerance = absoluteTolerance;
+		}
+		
+		void
+		DormandPrinceIntegrator::setMinimumStep(const ::rl::math::Real& minimumStep)
+		{
+			this->minimumStep = minimumStep;
+		}
+		
+		void
+		DormandPrinceIntegrator::setRelativeTolerance(const ::rl::math::Real& relativeTolerance)
+		{
+			this->relativeTolerance = relativeTolerance;
+		}
+		
+		void
+		DormandPrinceIntegrator::setStep(const ::rl::math::Real& step)
+		{
+			this->step = step;
+		}
+	}
+}
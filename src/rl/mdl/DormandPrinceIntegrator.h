@@ -0,0 +1,178 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_MDL_DORMANDPRINCEINTEGRATOR_H
+#define RL_MDL_DORMANDPRINCEINTEGRATOR_H
+
+#include <vector>
+#include <rl/math/Matrix.h>
+#include <rl/math/Vector.h>
+
+#include "Integrator.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		/**
+		 * Adaptive integration via the embedded Dormand-Prince 5(4) method.
+		 *
+		 * integrate() covers the interval \f$\Delta t\f$ with as many internal
+		 * steps as required to keep the estimated local error of positions and
+		 * velocities within the tolerances
+		 * \f[ \sqrt{\frac{1}{2n} \sum_{j} \left( \frac{e_{j}}{a + r \max(|y_{j}|, |y_{j}'|)} \right)^{2}} \leq 1 \f]
+		 * with absolute tolerance \f$a\f$ and relative tolerance \f$r\f$. The step
+		 * size estimate is kept between calls, so free motion is covered with few
+		 * large steps. The torque is kept constant during integrate().
+		 *
+		 * All intermediate values are held in a workspace that is only
+		 * reallocated if the degrees of freedom change or more internal steps
+		 * than before are needed for dense output.
+		 *
+		 * J. R. Dormand and P. J. Prince. A family of embedded Runge-Kutta formulae.
+		 * Journal of Computational and Applied Mathematics, 6(1):19-26, 1980.
+		 *
+		 * @pre Dynamic::getDofPosition() == Dynamic::getDof()
+		 * @pre Dynamic::setPosition()
+		 * @pre Dynamic::setVelocity()
+		 * @pre Dynamic::setTorque()
+		 * @post Dynamic::getPosition()
+		 * @post Dynamic::getVelocity()
+		 * @post Dynamic::getAcceleration()
+		 *
+		 * @see Dynamic::forwardDynamics()
+		 */
+		class RL_MDL_EXPORT DormandPrinceIntegrator : public Integrator
+		{
+		public:
+			DormandPrinceIntegrator(Dynamic* dynamic);
+			
+			virtual ~DormandPrinceIntegrator();
+			
+			const ::rl::math::Real& getAbsoluteTolerance() const;
+			
+			/**
+			 * Number of accepted internal steps of the last call to integrate().
+			 */
+			const ::std::size_t& getAcceptedSteps() const;
+			
+			const ::rl::math::Real& getMinimumStep() const;
+			
+			/**
+			 * Number of rejected internal steps of the last call to integrate().
+			 */
+			const ::std::size_t& getRejectedSteps() const;
+			
+			const ::rl::math::Real& getRelativeTolerance() const;
+			
+			/**
+			 * Step size estimate for the next internal step.
+			 */
+			const ::rl::math::Real& getStep() const;
+			
+			/**
+			 * @throws Exception If the step size falls below getMinimumStep()
+			 */
+			void integrate(const ::rl::math::Real& dt);
+			
+			/**
+			 * Dense output of the last call to integrate().
+			 *
+			 * Evaluates the fourth-order continuous extension of the internal step
+			 * containing t.
+			 *
+			 * @param[in] t Time relative to the start of the last integrate(), \f$0 \leq t \leq \Delta t\f$
+			 * @param[out] q Joint positions at t
+			 * @param[out] qd Joint velocities at t
+			 * @pre integrate()
+			 */
+			void interpolate(const ::rl::math::Real& t, ::rl::math::Vector& q, ::rl::math::Vector& qd) const;
+			
+			void setAbsoluteTolerance(const ::rl::math::Real& absoluteTolerance);
+			
+			void setMinimumStep(const ::rl::math::Real& minimumStep);
+			
+			void setRelativeTolerance(const ::rl::math::Real& relativeTolerance);
+			
+			/**
+			 * Set step size estimate for the next internal step.
+			 *
+			 * A value of zero starts with the full interval of integrate().
+			 */
+			void setStep(const ::rl::math::Real& step);
+			
+		protected:
+			
+		private:
+			void resize(const ::std::size_t& n);
+			
+			::rl::math::Real absoluteTolerance;
+			
+			::std::size_t acceptedSteps;
+			
+			/** Coefficients of continuous extension for positions, five columns per step. */
+			::rl::math::Matrix continuousPosition;
+			
+			/** Coefficients of continuous extension for velocities, five columns per step. */
+			::rl::math::Matrix continuousVelocity;
+			
+			/** Stage accelerations. */
+			::rl::math::Matrix kAcceleration;
+			
+			/** Stage velocities. */
+			::rl::math::Matrix kVelocity;
+			
+			::rl::math::Real minimumStep;
+			
+			::rl::math::Vector q;
+			
+			::rl::math::Vector q0;
+			
+			::rl::math::Vector q1;
+			
+			::rl::math::Vector qd;
+			
+			::rl::math::Vector qd0;
+			
+			::rl::math::Vector qd1;
+			
+			::rl::math::Vector qdd;
+			
+			::rl::math::Vector qdd0;
+			
+			::std::size_t rejectedSteps;
+			
+			::rl::math::Real relativeTolerance;
+			
+			::rl::math::Real step;
+			
+			/** Start times of accepted internal steps. */
+			::std::vector<::rl::math::Real> times;
+		};
+	}
+}
+
+#endif // RL_MDL_DORMANDPRINCEINTEGRATOR_H
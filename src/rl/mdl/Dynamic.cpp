@@ -25,6 +25,7 @@
 //
 
 #include <algorithm>
+#include <limits>
 #include <stack>
 #include <boost/graph/graphviz.hpp>
 #include <rl/math/Quaternion.h>
@@ -32,8 +33,10 @@
 #include <rl/math/Spatial.h>
 #include <rl/math/Unit.h>
 
+#include "Body.h"
 #include "Exception.h"
 #include "Dynamic.h"
+#include "Joint.h"
 #include "Prismatic.h"
 #include "Revolute.h"
 #include "World.h"
@@ -48,7 +51,14 @@ namespace rl
 			invM(),
 			invMx(),
 			M(),
-			V()
+			V(),
+			accelerationDerivatives(),
+			columns(),
+			forceDerivatives(),
+			inertias(),
+			massMatrixInverseMethod(MASS_MATRIX_INVERSE_METHOD_ABA),
+			massMatrixMethod(MASS_MATRIX_METHOD_CRBA),
+			velocityDerivatives()
 		{
 		}
 		
@@ -78,6 +88,26 @@ namespace rl
 			this->setWorldGravity(g);
 		}
 		
+		void
+		Dynamic::calculateForwardDynamicsDerivatives(::rl::math::Matrix& dqdddq, ::rl::math::Matrix& dqdddqd, ::rl::math::Matrix& dqdddtau)
+		{
+			::rl::math::Vector tau = this->getTorque();
+			
+			// generic pass, overrides need not update body states read below
+			this->Dynamic::forwardDynamics();
+			
+			// inverse dynamics at accelerations of forward dynamics
+			this->calculateInverseDynamicsDerivatives(dqdddq, dqdddqd);
+			this->setTorque(tau);
+			
+			this->calculateMassMatrixInverseAba(dqdddtau);
+			
+			// -M^-1 * dtau/dq
+			dqdddq = -dqdddtau * dqdddq;
+			// -M^-1 * dtau/dqd
+			dqdddqd = -dqdddtau * dqdddqd;
+		}
+		
 		void
 		Dynamic::calculateGravity()
 		{
@@ -96,6 +126,149 @@ namespace rl
 			G = this->getTorque();
 		}
 		
+		void
+		Dynamic::calculateInverseDynamicsDerivatives(::rl::math::Matrix& dtaudq, ::rl::math::Matrix& dtaudqd)
+		{
+			::std::size_t npos = ::std::numeric_limits<::std::size_t>::max();
+			::std::size_t dof = this->getDof();
+			
+			// generic pass, overrides need not update body states read below
+			this->Dynamic::inverseDynamics();
+			
+			dtaudq.resize(dof, dof);
+			dtaudqd.resize(dof, dof);
+			
+			// forward pass, columns beyond ancestors are zero, d(X * m) / dq = -s x X * m
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
+			{
+				Transform* transform = this->transforms[i];
+				::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>& da = this->accelerationDerivatives[i];
+				::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>& df = this->forceDerivatives[i];
+				::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>& dv = this->velocityDerivatives[i];
+				::std::size_t size = npos != this->indices[i] ? this->offsets[i] + this->joints[this->indices[i]]->getDof() : this->offsets[i];
+				::std::size_t previous = 0;
+				
+				if (npos != this->parents[i])
+				{
+					previous = npos != this->indices[this->parents[i]] ? this->offsets[this->parents[i]] + this->joints[this->indices[this->parents[i]]]->getDof() : this->offsets[this->parents[i]];
+					::rl::math::Matrix66 x = transform->x.matrixMotion();
+					::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>& parentDa = this->accelerationDerivatives[this->parents[i]];
+					::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>& parentDv = this->velocityDerivatives[this->parents[i]];
+					
+					// X * dv
+					dv.leftCols(previous).noalias() = x * parentDv.leftCols(previous);
+					dv.middleCols(dof, previous).noalias() = x * parentDv.middleCols(dof, previous);
+					// X * da
+					da.leftCols(previous).noalias() = x * parentDa.leftCols(previous);
+					da.middleCols(dof, previous).noalias() = x * parentDa.middleCols(dof, previous);
+				}
+				
+				dv.middleCols(previous, size - previous).setZero();
+				dv.middleCols(dof + previous, size - previous).setZero();
+				da.middleCols(previous, size - previous).setZero();
+				da.middleCols(dof + previous, size - previous).setZero();
+				
+				if (npos != this->indices[i])
+				{
+					Joint* joint = this->joints[this->indices[i]];
+					::rl::math::MotionVector xv = transform->x * transform->in->v;
+					::rl::math::MotionVector xa = transform->x * transform->in->a;
+					
+					for (::std::size_t j = 0; j < joint->getDof(); ++j)
+					{
+						::rl::math::MotionVector s(joint->S.col(j));
+						// X * v x s
+						dv.col(this->offsets[i] + j) = xv.cross(s).matrix();
+						// X * a x s
+						da.col(this->offsets[i] + j) = xa.cross(s).matrix();
+						// s
+						dv.col(dof + this->offsets[i] + j) = s.matrix();
+						// v x s
+						da.col(dof + this->offsets[i] + j) = transform->out->v.cross(s).matrix();
+					}
+					
+					::rl::math::Matrix66 vj = joint->v.cross66Motion();
+					
+					// dv x vj
+					da.leftCols(size).noalias() -= vj * dv.leftCols(size);
+					da.middleCols(dof, size).noalias() -= vj * dv.middleCols(dof, size);
+				}
+				
+				df.middleCols(size, this->ends[i] - size).setZero();
+				df.middleCols(dof + size, this->ends[i] - size).setZero();
+				
+				if (Body* body = dynamic_cast<Body*>(transform->out))
+				{
+					::rl::math::Matrix66 inertia = body->i.matrix();
+					// v x* I + (I * v)x*, with dv x* I * v = (I * v)x* * dv
+					::rl::math::Matrix66 k = body->v.cross66Force() * inertia + Dynamic::crossForce(body->i * body->v);
+					
+					// I * da + v x* I * dv + dv x* I * v
+					df.leftCols(size).noalias() = inertia * da.leftCols(size);
+					df.leftCols(size).noalias() += k * dv.leftCols(size);
+					df.middleCols(dof, size).noalias() = inertia * da.middleCols(dof, size);
+					df.middleCols(dof, size).noalias() += k * dv.middleCols(dof, size);
+					
+					if (!body->fX.matrix().isZero())
+					{
+						// d(-X_0 * f^x) / dq with joint axes dv / dqd in body frame
+						df.leftCols(size).noalias() += Dynamic::crossForce(body->x * body->fX) * dv.middleCols(dof, size);
+					}
+				}
+				else
+				{
+					df.leftCols(size).setZero();
+					df.middleCols(dof, size).setZero();
+				}
+			}
+			
+			// backward pass, subtree and ancestor columns, d(X^* * f) / dq = X^* * (s x* f)
+			for (::std::size_t i = this->transforms.size(); i-- > 0;)
+			{
+				Transform* transform = this->transforms[i];
+				::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>& df = this->forceDerivatives[i];
+				::std::size_t size = this->ends[i];
+				
+				if (npos != this->indices[i])
+				{
+					Joint* joint = this->joints[this->indices[i]];
+					// S^T * df
+					dtaudq.block(this->offsets[i], 0, joint->getDof(), size).noalias() = joint->S.transpose() * df.leftCols(size);
+					dtaudq.block(this->offsets[i], size, joint->getDof(), dof - size).setZero();
+					dtaudqd.block(this->offsets[i], 0, joint->getDof(), size).noalias() = joint->S.transpose() * df.middleCols(dof, size);
+					dtaudqd.block(this->offsets[i], size, joint->getDof(), dof - size).setZero();
+				}
+				
+				if (npos != this->parents[i])
+				{
+					::rl::math::Matrix66 x = transform->x.inverseForce();
+					::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>& parent = this->forceDerivatives[this->parents[i]];
+					
+					// X^* * df
+					parent.leftCols(size).noalias() += x * df.leftCols(size);
+					parent.middleCols(dof, size).noalias() += x * df.middleCols(dof, size);
+					
+					if (npos != this->indices[i])
+					{
+						Joint* joint = this->joints[this->indices[i]];
+						
+						for (::std::size_t j = 0; j < joint->getDof(); ++j)
+						{
+							::rl::math::MotionVector s(joint->S.col(j));
+							// X^* * (s x* f)
+							parent.col(this->offsets[i] + j) += (transform->x / s.cross(transform->out->f)).matrix();
+						}
+					}
+				}
+			}
+			
+			if (!this->gammaVelocityIdentity)
+			{
+				dtaudq = dtaudq * this->gammaVelocity;
+				dtaudqd = dtaudqd * this->gammaVelocity;
+			}
+		}
+		
 		void
 		Dynamic::calculateMassMatrix()
 		{
@@ -105,6 +278,12 @@ namespace rl
 		void
 		Dynamic::calculateMassMatrix(::rl::math::Matrix& M)
 		{
+			if (MASS_MATRIX_METHOD_CRBA == this->massMatrixMethod)
+			{
+				this->calculateMassMatrixCrba(M);
+				return;
+			}
+			
 			::rl::math::Vector3 g = this->getWorldGravity();
 			
 			::rl::math::Vector tmp = ::rl::math::Vector::Zero(this->getDof());
@@ -128,6 +307,71 @@ namespace rl
 			this->setWorldGravity(g);
 		}
 		
+		void
+		Dynamic::calculateMassMatrixCrba(::rl::math::Matrix& M)
+		{
+			::std::size_t npos = ::std::numeric_limits<::std::size_t>::max();
+			
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
+			{
+				if (Body* body = dynamic_cast<Body*>(this->transforms[i]->out))
+				{
+					this->inertias[i] = body->i;
+				}
+				else
+				{
+					this->inertias[i] = ::rl::math::ArticulatedBodyInertia::Zero();
+				}
+			}
+			
+			// composite inertia of each subtree
+			for (::std::size_t i = this->transforms.size(); i-- > 0;)
+			{
+				if (npos != this->parents[i])
+				{
+					// I^c + X^* * I^c * X
+					this->inertias[this->parents[i]] = this->inertias[this->parents[i]] + this->transforms[i]->x / this->inertias[i];
+				}
+			}
+			
+			M.setZero(this->getDof(), this->getDof());
+			
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
+			{
+				if (npos == this->indices[i])
+				{
+					continue;
+				}
+				
+				Joint* joint = this->joints[this->indices[i]];
+				
+				// I^c * S
+				::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic, ::Eigen::ColMajor, 6, 6> F = this->inertias[i].matrix() * joint->S;
+				
+				// S^T * F
+				M.block(this->offsets[i], this->offsets[i], joint->getDof(), joint->getDof()) = joint->S.transpose() * F;
+				
+				for (::std::size_t j = i; npos != this->parents[j];)
+				{
+					// X^* * F
+					F = this->transforms[j]->x.inverseForce() * F;
+					j = this->parents[j];
+					
+					if (npos != this->indices[j])
+					{
+						Joint* ancestor = this->joints[this->indices[j]];
+						M.block(this->offsets[j], this->offsets[i], ancestor->getDof(), joint->getDof()) = ancestor->S.transpose() * F;
+						M.block(this->offsets[i], this->offsets[j], joint->getDof(), ancestor->getDof()) = M.block(this->offsets[j], this->offsets[i], ancestor->getDof(), joint->getDof()).transpose();
+					}
+				}
+			}
+			
+			if (!this->gammaVelocityIdentity)
+			{
+				M = M * this->gammaVelocity;
+			}
+		}
+		
 		void
 		Dynamic::calculateMassMatrixInverse()
 		{
@@ -137,6 +381,12 @@ namespace rl
 		void
 		Dynamic::calculateMassMatrixInverse(::rl::math::Matrix& invM)
 		{
+			if (MASS_MATRIX_INVERSE_METHOD_ABA == this->massMatrixInverseMethod)
+			{
+				this->calculateMassMatrixInverseAba(invM);
+				return;
+			}
+			
 			::rl::math::Vector3 g = this->getWorldGravity();
 			
 			::rl::math::Vector tmp = ::rl::math::Vector::Zero(this->getDof());
@@ -160,6 +410,108 @@ namespace rl
 			this->setWorldGravity(g);
 		}
 		
+		void
+		Dynamic::calculateMassMatrixInverseAba(::rl::math::Matrix& invM)
+		{
+			::std::size_t npos = ::std::numeric_limits<::std::size_t>::max();
+			::std::size_t dof = this->getDof();
+			
+			invM.setZero(dof, dof);
+			
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
+			{
+				if (Body* body = dynamic_cast<Body*>(this->transforms[i]->out))
+				{
+					this->inertias[i] = body->i;
+				}
+				else
+				{
+					this->inertias[i] = ::rl::math::ArticulatedBodyInertia::Zero();
+				}
+				
+				this->columns[i].setZero();
+			}
+			
+			// backward pass with unit torques, p^A only has columns of its subtree
+			for (::std::size_t i = this->transforms.size(); i-- > 0;)
+			{
+				::std::size_t offset = this->offsets[i];
+				::std::size_t size = this->ends[i] - offset;
+				
+				if (npos == this->indices[i])
+				{
+					if (npos != this->parents[i])
+					{
+						this->inertias[this->parents[i]] = this->inertias[this->parents[i]] + this->transforms[i]->x / this->inertias[i];
+						this->columns[this->parents[i]].middleCols(offset, size).noalias() += this->transforms[i]->x.inverseForce() * this->columns[i].middleCols(offset, size);
+					}
+					
+					continue;
+				}
+				
+				Joint* joint = this->joints[this->indices[i]];
+				::std::size_t n = joint->getDof();
+				
+				// I^A * S
+				joint->U = this->inertias[i].matrix() * joint->S;
+				// S^T * U
+				joint->D = joint->S.transpose() * joint->U;
+				::Eigen::Matrix<::rl::math::Real, ::Eigen::Dynamic, ::Eigen::Dynamic, ::Eigen::ColMajor, 6, 6> invD = joint->D.inverse();
+				
+				// D^-1 * (1 - S^T * p^A)
+				invM.block(offset, offset, n, n) = invD;
+				invM.block(offset, offset + n, n, size - n).noalias() = -invD * joint->S.transpose() * this->columns[i].middleCols(offset + n, size - n);
+				
+				if (npos != this->parents[i])
+				{
+					// I^A - U * D^-1 * U^T
+					::rl::math::ArticulatedBodyInertia ia(this->inertias[i] - ::rl::math::ArticulatedBodyInertia(joint->U * invD * joint->U.transpose()));
+					// I^A + X^* * I^a * X
+					this->inertias[this->parents[i]] = this->inertias[this->parents[i]] + this->transforms[i]->x / ia;
+					// p^A + U * D^-1 * u
+					this->columns[i].middleCols(offset, size).noalias() += joint->U * invM.block(offset, offset, n, size);
+					// p^A + X^* * p^a
+					this->columns[this->parents[i]].middleCols(offset, size).noalias() += this->transforms[i]->x.inverseForce() * this->columns[i].middleCols(offset, size);
+				}
+			}
+			
+			// forward pass, accelerations only needed for upper triangle
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
+			{
+				::std::size_t offset = this->offsets[i];
+				::std::size_t size = dof - offset;
+				
+				if (npos != this->parents[i])
+				{
+					// X * a
+					this->columns[i].rightCols(size).noalias() = this->transforms[i]->x.matrixMotion() * this->columns[this->parents[i]].rightCols(size);
+				}
+				else
+				{
+					this->columns[i].rightCols(size).setZero();
+				}
+				
+				if (npos != this->indices[i])
+				{
+					Joint* joint = this->joints[this->indices[i]];
+					::std::size_t n = joint->getDof();
+					
+					// D^-1 * (u - U^T * a')
+					::Eigen::Matrix<::rl::math::Real, ::Eigen::Dynamic, ::Eigen::Dynamic, ::Eigen::ColMajor, 6, 6> invD = joint->D.inverse();
+					invM.block(offset, offset, n, size).noalias() -= invD * joint->U.transpose() * this->columns[i].rightCols(size);
+					// a' + S * qdd
+					this->columns[i].rightCols(size).noalias() += joint->S * invM.block(offset, offset, n, size);
+				}
+			}
+			
+			invM.triangularView<::Eigen::StrictlyLower>() = invM.transpose();
+			
+			if (!this->gammaVelocityIdentity)
+			{
+				invM = this->invGammaVelocity * invM;
+			}
+		}
+		
 		void
 		Dynamic::calculateOperationalMassMatrixInverse()
 		{
@@ -172,6 +524,23 @@ namespace rl
 			invMx = J * invM * J.transpose();
 		}
 		
+		Dynamic*
+		Dynamic::clone() const
+		{
+			return new Dynamic(*this);
+		}
+		
+		::rl::math::Matrix66
+		Dynamic::crossForce(const ::rl::math::ForceVector& f)
+		{
+			::rl::math::Matrix66 res;
+			res.topLeftCorner<3, 3>() = -f.moment().cross33();
+			res.topRightCorner<3, 3>() = -f.force().cross33();
+			res.bottomLeftCorner<3, 3>() = -f.force().cross33();
+			res.bottomRightCorner<3, 3>().setZero();
+			return res;
+		}
+		
 		void
 		Dynamic::forwardDynamics()
 		{
@@ -215,6 +584,18 @@ namespace rl
 			return this->M;
 		}
 		
+		const Dynamic::MassMatrixInverseMethod&
+		Dynamic::getMassMatrixInverseMethod() const
+		{
+			return this->massMatrixInverseMethod;
+		}
+		
+		const Dynamic::MassMatrixMethod&
+		Dynamic::getMassMatrixMethod() const
+		{
+			return this->massMatrixMethod;
+		}
+		
 		const ::rl::math::Matrix&
 		Dynamic::getOperationalMassMatrixInverse() const
 		{
@@ -244,11 +625,29 @@ namespace rl
 			}
 		}
 		
+		void
+		Dynamic::setMassMatrixInverseMethod(const MassMatrixInverseMethod& massMatrixInverseMethod)
+		{
+			this->massMatrixInverseMethod = massMatrixInverseMethod;
+		}
+		
+		void
+		Dynamic::setMassMatrixMethod(const MassMatrixMethod& massMatrixMethod)
+		{
+			this->massMatrixMethod = massMatrixMethod;
+		}
+		
 		void
 		Dynamic::update()
 		{
 			Kinematic::update();
 			
+			this->accelerationDerivatives.assign(this->transforms.size(), ::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>::Zero(6, 2 * this->getDof()));
+			this->columns.assign(this->transforms.size(), ::rl::math::Matrix::Zero(6, this->getDof()));
+			this->forceDerivatives.assign(this->transforms.size(), ::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>::Zero(6, 2 * this->getDof()));
+			this->inertias.assign(this->transforms.size(), ::rl::math::ArticulatedBodyInertia::Zero());
+			this->velocityDerivatives.assign(this->transforms.size(), ::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>::Zero(6, 2 * this->getDof()));
+			
 			this->M = ::rl::math::Matrix::Identity(this->getDof(), this->getDof());
 			this->V = ::rl::math::Vector::Zero(this->getDof());
 			this->G = ::rl::math::Vector::Zero(this->getDof());
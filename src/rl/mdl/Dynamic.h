@@ -27,6 +27,9 @@
 #ifndef RL_MDL_DYNAMIC_H
 #define RL_MDL_DYNAMIC_H
 
+#include <vector>
+#include <rl/math/Spatial.h>
+
 #include "Kinematic.h"
 
 namespace rl
@@ -36,6 +39,37 @@ namespace rl
 		class RL_MDL_EXPORT Dynamic : public Kinematic
 		{
 		public:
+			/**
+			 * Algorithm for calculating the joint space mass matrix inverse.
+			 */
+			enum MassMatrixInverseMethod
+			{
+				/**
+				 * Direct O(n^2) inverse via articulated-body algorithm.
+				 *
+				 * Justin Carpentier, Analytical Inverse of the Joint Space Inertia
+				 * Matrix, 2018.
+				 */
+				MASS_MATRIX_INVERSE_METHOD_ABA,
+				/** One forward dynamics pass per column. */
+				MASS_MATRIX_INVERSE_METHOD_FORWARD_DYNAMICS
+			};
+			
+			/**
+			 * Algorithm for calculating the joint space mass matrix.
+			 */
+			enum MassMatrixMethod
+			{
+				/**
+				 * Composite-rigid-body algorithm.
+				 *
+				 * Roy Featherstone, Rigid Body Dynamics Algorithms, 2008.
+				 */
+				MASS_MATRIX_METHOD_CRBA,
+				/** One inverse dynamics pass per column. */
+				MASS_MATRIX_METHOD_INVERSE_DYNAMICS
+			};
+			
 			Dynamic();
 			
 			virtual ~Dynamic();
@@ -63,6 +97,30 @@ namespace rl
 			 */
 			void calculateCentrifugalCoriolis(::rl::math::Vector& V);
 			
+			/**
+			 * Calculate partial derivatives of forward dynamics.
+			 *
+			 * Runs forward dynamics, differentiates inverse dynamics at the
+			 * resulting accelerations and multiplies by the mass matrix inverse,
+			 * \f$\frac{\partial \ddot{\vec{q}}}{\partial \vec{q}} = -\matr{M}^{-1} \frac{\partial \vec{\tau}}{\partial \vec{q}}\f$.
+			 * Position derivatives are taken with respect to a step in velocity
+			 * coordinates as in step().
+			 *
+			 * @param[out] dqdddq Partial derivative \f$\frac{\partial \ddot{\vec{q}}}{\partial \vec{q}}\f$
+			 * @param[out] dqdddqd Partial derivative \f$\frac{\partial \ddot{\vec{q}}}{\partial \dot{\vec{q}}}\f$
+			 * @param[out] dqdddtau Partial derivative \f$\frac{\partial \ddot{\vec{q}}}{\partial \vec{\tau}} = \matr{M}^{-1}(\vec{q})\f$
+			 *
+			 * @pre setPosition()
+			 * @pre setVelocity()
+			 * @pre setTorque()
+			 * @pre forwardPosition() if bodies have external forces
+			 * @post getAcceleration()
+			 *
+			 * @see forwardDynamics()
+			 * @see calculateInverseDynamicsDerivatives()
+			 */
+			void calculateForwardDynamicsDerivatives(::rl::math::Matrix& dqdddq, ::rl::math::Matrix& dqdddqd, ::rl::math::Matrix& dqdddtau);
+			
 			/**
 			 * Calculate gravity vector.
 			 *
@@ -84,13 +142,34 @@ namespace rl
 			 */
 			void calculateGravity(::rl::math::Vector& G);
 			
+			/**
+			 * Calculate partial derivatives of inverse dynamics.
+			 *
+			 * Propagates the derivatives of velocities, accelerations and forces
+			 * with respect to all joint positions and velocities through the
+			 * recursive Newton-Euler algorithm. Position derivatives are taken
+			 * with respect to a step in velocity coordinates as in step().
+			 *
+			 * @param[out] dtaudq Partial derivative \f$\frac{\partial \vec{\tau}}{\partial \vec{q}}\f$
+			 * @param[out] dtaudqd Partial derivative \f$\frac{\partial \vec{\tau}}{\partial \dot{\vec{q}}}\f$
+			 *
+			 * @pre setPosition()
+			 * @pre setVelocity()
+			 * @pre setAcceleration()
+			 * @pre forwardPosition() if bodies have external forces
+			 * @post getTorque()
+			 *
+			 * @see inverseDynamics()
+			 */
+			void calculateInverseDynamicsDerivatives(::rl::math::Matrix& dtaudq, ::rl::math::Matrix& dtaudqd);
+			
 			/**
 			 * Calculate joint space mass matrix.
 			 *
 			 * @pre setPosition()
 			 * @post getMassMatrix()
 			 *
-			 * @see inverseDynamics()
+			 * @see setMassMatrixMethod()
 			 */
 			void calculateMassMatrix();
 			
@@ -101,9 +180,9 @@ namespace rl
 			 *
 			 * @pre setPosition()
 			 *
-			 * @see inverseDynamics()
+			 * @see setMassMatrixMethod()
 			 */
-			void calculateMassMatrix(::rl::math::Matrix& M);
+			virtual void calculateMassMatrix(::rl::math::Matrix& M);
 			
 			/**
 			 * Calculate joint space mass matrix inverse.
@@ -111,7 +190,7 @@ namespace rl
 			 * @pre setPosition()
 			 * @post getMassMatrixInverse()
 			 *
-			 * @see forwardDynamics()
+			 * @see setMassMatrixInverseMethod()
 			 */
 			void calculateMassMatrixInverse();
 			
@@ -122,7 +201,7 @@ namespace rl
 			 *
 			 * @pre setPosition()
 			 *
-			 * @see forwardDynamics()
+			 * @see setMassMatrixInverseMethod()
 			 */
 			void calculateMassMatrixInverse(::rl::math::Matrix& invM);
 			
@@ -146,6 +225,8 @@ namespace rl
 			 */
 			void calculateOperationalMassMatrixInverse(const ::rl::math::Matrix& J, const ::rl::math::Matrix& invM, ::rl::math::Matrix& invMx) const;
 			
+			Dynamic* clone() const;
+			
 			/**
 			 * Forward dynamics via articulated-body algorithm.
 			 *
@@ -156,7 +237,7 @@ namespace rl
 			 * @pre setTorque()
 			 * @post getAcceleration()
 			 */
-			void forwardDynamics();
+			virtual void forwardDynamics();
 			
 			/**
 			 * Access calculated centrifugal and Coriolis vector.
@@ -190,6 +271,8 @@ namespace rl
 			 */
 			const ::rl::math::Matrix& getMassMatrixInverse() const;
 			
+			const MassMatrixInverseMethod& getMassMatrixInverseMethod() const;
+			
 			/**
 			 * Access calculated joint space mass matrix.
 			 *
@@ -199,6 +282,8 @@ namespace rl
 			 */
 			const ::rl::math::Matrix& getMassMatrix() const;
 			
+			const MassMatrixMethod& getMassMatrixMethod() const;
+			
 			/**
 			 * Access calculated operational space mass matrix inverse.
 			 *
@@ -222,10 +307,14 @@ namespace rl
 			 * @pre setAcceleration()
 			 * @post getTorque()
 			 */
-			void inverseDynamics();
+			virtual void inverseDynamics();
 			
 			void inverseForce();
 			
+			void setMassMatrixInverseMethod(const MassMatrixInverseMethod& massMatrixInverseMethod);
+			
+			void setMassMatrixMethod(const MassMatrixMethod& massMatrixMethod);
+			
 			virtual void update();
 			
 		protected:
@@ -285,7 +374,52 @@ namespace rl
 			::rl::math::Vector V;
 			
 		private:
+			void calculateMassMatrixCrba(::rl::math::Matrix& M);
+			
+			void calculateMassMatrixInverseAba(::rl::math::Matrix& invM);
+			
+			/**
+			 * Matrix of the spatial cross product with a force vector, m x* f = crossForce(f) * m.
+			 */
+			static ::rl::math::Matrix66 crossForce(const ::rl::math::ForceVector& f);
+			
+			/**
+			 * Derivatives of spatial accelerations per transform.
+			 *
+			 * Columns with respect to joint positions followed by joint velocities.
+			 */
+			::std::vector<::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>> accelerationDerivatives;
 			
+			/**
+			 * Spatial force or motion columns per transform.
+			 *
+			 * Articulated-body forces in the backward pass and accelerations
+			 * in the forward pass of the mass matrix inverse.
+			 */
+			::std::vector<::rl::math::Matrix> columns;
+			
+			/**
+			 * Derivatives of spatial forces per transform.
+			 *
+			 * Columns with respect to joint positions followed by joint velocities.
+			 */
+			::std::vector<::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>> forceDerivatives;
+			
+			/**
+			 * Composite or articulated-body inertia per transform.
+			 */
+			::std::vector<::rl::math::ArticulatedBodyInertia> inertias;
+			
+			MassMatrixInverseMethod massMatrixInverseMethod;
+			
+			MassMatrixMethod massMatrixMethod;
+			
+			/**
+			 * Derivatives of spatial velocities per transform.
+			 *
+			 * Columns with respect to joint positions followed by joint velocities.
+			 */
+			::std::vector<::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic>> velocityDerivatives;
 		};
 	}
 }
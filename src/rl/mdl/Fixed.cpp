@@ -38,5 +38,11 @@ namespace rl
 		Fixed::~Fixed()
 		{
 		}
+		
+		Fixed*
+		Fixed::clone() const
+		{
+			return new Fixed(*this);
+		}
 	}
 }
@@ -40,6 +40,8 @@ namespace rl
 			
 			virtual ~Fixed();
 			
+			Fixed* clone() const;
+			
 		protected:
 			
 		private:
@@ -48,6 +48,12 @@ namespace rl
 		{
 		}
 		
+		Frame*
+		Frame::clone() const
+		{
+			return new Frame(*this);
+		}
+		
 		void
 		Frame::forwardAcceleration()
 		{
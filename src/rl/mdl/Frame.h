@@ -56,6 +56,8 @@ namespace rl
 			
 			virtual ~Frame();
 			
+			virtual Frame* clone() const;
+			
 			virtual void forwardAcceleration();
 			
 			virtual void forwardDynamics1();
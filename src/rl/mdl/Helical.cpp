@@ -49,6 +49,24 @@ namespace rl
 		{
 		}
 		
+		void
+		Helical::calculateBatch(const ::rl::math::ConstMatrixRef& q, Batch& x) const
+		{
+			x.resize(12, q.cols());
+			Joint::setBatchRotation(this->S.block<3, 1>(0, 0), q.row(0).array(), x);
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				x.row(9 + i) = this->S(3 + i, 0) * this->h * (q.row(0).array() + this->offset(0));
+			}
+		}
+		
+		Helical*
+		Helical::clone() const
+		{
+			return new Helical(*this);
+		}
+		
 		::rl::math::Real
 		Helical::getPitch() const
 		{
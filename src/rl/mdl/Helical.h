@@ -40,6 +40,10 @@ namespace rl
 			
 			virtual ~Helical();
 			
+			void calculateBatch(const ::rl::math::ConstMatrixRef& q, Batch& x) const;
+			
+			Helical* clone() const;
+			
 			::rl::math::Real getPitch() const;
 			
 			void setPitch(const ::rl::math::Real& h);
@@ -38,5 +38,11 @@ namespace rl
 		Integrator::~Integrator()
 		{
 		}
+		
+		Dynamic*
+		Integrator::getDynamic() const
+		{
+			return this->dynamic;
+		}
 	}
 }
@@ -43,6 +43,8 @@ namespace rl
 			
 			virtual ~Integrator();
 			
+			Dynamic* getDynamic() const;
+			
 			/**
 			 * @param[in] dt Integration time step \f$\Delta t\f$
 			 */
@@ -113,15 +113,18 @@ namespace rl
 		Joint::forwardDynamics2()
 		{
 			// I^A * S
-			this->U = this->out->iA.matrix() * this->S;
+			this->U.noalias() = this->out->iA.matrix() * this->S;
 			// S^T * U
-			this->D = this->S.transpose() * this->U;
+			this->D.noalias() = this->S.transpose() * this->U;
 			// tau - S^T * p^A
-			this->u = this->tau - this->S.transpose() * this->out->pA.matrix();
+			this->u = this->tau;
+			this->u.noalias() -= this->S.transpose() * this->out->pA.matrix();
+			// U * D^-1
+			::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic, ::Eigen::ColMajor, 6, 6> UinvD = this->U * this->D.inverse();
 			// I^A - U * D^-1 * U^T
-			::rl::math::ArticulatedBodyInertia ia(this->out->iA - ::rl::math::ArticulatedBodyInertia(this->U * this->D.inverse() * this->U.transpose()));
+			::rl::math::ArticulatedBodyInertia ia(this->out->iA - ::rl::math::ArticulatedBodyInertia(UinvD * this->U.transpose()));
 			// p^A + I^a * c + U * D^-1 * u
-			::rl::math::ForceVector pa(this->out->pA + ia * this->out->c + ::rl::math::ForceVector(this->U * this->D.inverse() * this->u));
+			::rl::math::ForceVector pa(this->out->pA + ia * this->out->c + ::rl::math::ForceVector(UinvD * this->u));
 			// I^A + X^* * I^a * X
 			this->in->iA = this->in->iA + this->x / ia;
 			// p^A + X^* * p^a
@@ -134,7 +137,7 @@ namespace rl
 			// X * a + c
 			::rl::math::MotionVector a(this->x * this->in->a + this->out->c);
 			// D^-1 * (u - U^T * a')
-			this->qdd = this->D.inverse() * (this->u - this->U.transpose() * a.matrix());
+			this->qdd.noalias() = this->D.inverse() * (this->u - this->U.transpose() * a.matrix());
 			// S * qdd
 			this->a = this->S * this->qdd;
 			// a' + S * qdd
@@ -271,7 +274,7 @@ namespace rl
 		Joint::inverseForce()
 		{
 			// S^T * f
-			this->tau = this->S.transpose() * this->out->f.matrix();
+			this->tau.noalias() = this->S.transpose() * this->out->f.matrix();
 			
 			// f + X * f
 			this->in->f = this->in->f + this->x / this->out->f;
@@ -305,6 +308,65 @@ namespace rl
 			this->a = this->S * this->qdd;
 		}
 		
+		void
+		Joint::setBatchLinear(const ::rl::math::Matrix33& linear, Batch& x)
+		{
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				for (::std::size_t j = 0; j < 3; ++j)
+				{
+					x.row(3 * i + j).setConstant(linear(j, i));
+				}
+			}
+		}
+		
+		void
+		Joint::setBatchQuaternion(const ::rl::math::ConstMatrixRef& q, Batch& x)
+		{
+			// coefficients in order x, y, z, w, see ::Eigen::Quaternion::toRotationMatrix()
+			::Eigen::Array<::rl::math::Real, 1, ::Eigen::Dynamic> tx = 2 * q.row(0).array();
+			::Eigen::Array<::rl::math::Real, 1, ::Eigen::Dynamic> ty = 2 * q.row(1).array();
+			::Eigen::Array<::rl::math::Real, 1, ::Eigen::Dynamic> tz = 2 * q.row(2).array();
+			
+			x.row(0) = 1 - ty * q.row(1).array() - tz * q.row(2).array();
+			x.row(1) = tx * q.row(1).array() + tz * q.row(3).array();
+			x.row(2) = tx * q.row(2).array() - ty * q.row(3).array();
+			x.row(3) = tx * q.row(1).array() - tz * q.row(3).array();
+			x.row(4) = 1 - tx * q.row(0).array() - tz * q.row(2).array();
+			x.row(5) = ty * q.row(2).array() + tx * q.row(3).array();
+			x.row(6) = tx * q.row(2).array() + ty * q.row(3).array();
+			x.row(7) = ty * q.row(2).array() - tx * q.row(3).array();
+			x.row(8) = 1 - tx * q.row(0).array() - ty * q.row(1).array();
+		}
+		
+		void
+		Joint::setBatchRotation(const ::rl::math::Vector3& axis, const ::Eigen::Array<::rl::math::Real, 1, ::Eigen::Dynamic>& angle, Batch& x)
+		{
+			// R = cos * 1 + sin * [axis]x + (1 - cos) * axis * axis^T
+			::Eigen::Array<::rl::math::Real, 1, ::Eigen::Dynamic> c = angle.cos();
+			::Eigen::Array<::rl::math::Real, 1, ::Eigen::Dynamic> s = angle.sin();
+			::Eigen::Array<::rl::math::Real, 1, ::Eigen::Dynamic> t = 1 - c;
+			
+			x.row(0) = t * (axis.x() * axis.x()) + c;
+			x.row(1) = t * (axis.y() * axis.x()) + s * axis.z();
+			x.row(2) = t * (axis.z() * axis.x()) - s * axis.y();
+			x.row(3) = t * (axis.x() * axis.y()) - s * axis.z();
+			x.row(4) = t * (axis.y() * axis.y()) + c;
+			x.row(5) = t * (axis.z() * axis.y()) + s * axis.x();
+			x.row(6) = t * (axis.x() * axis.z()) + s * axis.y();
+			x.row(7) = t * (axis.y() * axis.z()) - s * axis.x();
+			x.row(8) = t * (axis.z() * axis.z()) + c;
+		}
+		
+		void
+		Joint::setBatchTranslation(const ::rl::math::Vector3& translation, Batch& x)
+		{
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				x.row(9 + i).setConstant(translation(i));
+			}
+		}
+		
 		void
 		Joint::setTorque(const ::rl::math::ConstVectorRef& tau)
 		{
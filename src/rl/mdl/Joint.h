@@ -27,6 +27,7 @@
 #ifndef RL_MDL_JOINT_H
 #define RL_MDL_JOINT_H
 
+#include <rl/math/Matrix.h>
 #include <rl/math/Unit.h>
 #include <rl/math/Vector.h>
 
@@ -39,10 +40,27 @@ namespace rl
 		class RL_MDL_EXPORT Joint : public Transform
 		{
 		public:
+			/**
+			 * Frames of a batch of configurations in structure-of-arrays layout.
+			 *
+			 * Each column holds one configuration, rows 0 to 8 the rotation matrix
+			 * in column-major order and rows 9 to 11 the translation, so that one
+			 * coefficient of all configurations is contiguous in memory.
+			 */
+			typedef ::Eigen::Array<::rl::math::Real, 12, ::Eigen::Dynamic, ::Eigen::RowMajor> Batch;
+			
 			Joint(const ::std::size_t& dofPosition, const ::std::size_t& dofVelocity);
 			
 			virtual ~Joint();
 			
+			/**
+			 * Calculate joint transforms for a batch of joint positions.
+			 *
+			 * @param[in] q Joint positions, one configuration per column
+			 * @param[out] x Joint transforms, one configuration per column
+			 */
+			virtual void calculateBatch(const ::rl::math::ConstMatrixRef& q, Batch& x) const = 0;
+			
 			virtual void clamp(::rl::math::VectorRef q) const;
 			
 			virtual ::rl::math::Real distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const;
@@ -115,7 +133,7 @@ namespace rl
 			
 			::rl::math::MotionVector c;
 			
-			::rl::math::Matrix D;
+			::Eigen::Matrix<::rl::math::Real, ::Eigen::Dynamic, ::Eigen::Dynamic, ::Eigen::ColMajor, 6, 6> D;
 			
 			::rl::math::Vector max;
 			
@@ -135,7 +153,14 @@ namespace rl
 			
 			::Eigen::Matrix<::rl::math::Unit, ::Eigen::Dynamic, 1> qddUnits;
 			
-			::rl::math::Matrix S;
+			/**
+			 * Motion subspace.
+			 *
+			 * Spatial quantities of the articulated-body and recursive Newton-Euler
+			 * algorithms use fixed-capacity storage of at most six columns, so a
+			 * dynamics pass does not allocate on the heap.
+			 */
+			::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic, ::Eigen::ColMajor, 6, 6> S;
 			
 			::rl::math::Vector speed;
 			
@@ -145,15 +170,22 @@ namespace rl
 			
 			::Eigen::Matrix<::rl::math::Unit, ::Eigen::Dynamic, 1> tauUnits;
 			
-			::rl::math::Vector u;
+			::Eigen::Matrix<::rl::math::Real, ::Eigen::Dynamic, 1, ::Eigen::ColMajor, 6, 1> u;
 			
-			::rl::math::Matrix U;
+			::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic, ::Eigen::ColMajor, 6, 6> U;
 			
 			::rl::math::MotionVector v;
 			
 			::Eigen::Matrix<bool, ::Eigen::Dynamic, 1> wraparound;
 			
 		protected:
+			static void setBatchLinear(const ::rl::math::Matrix33& linear, Batch& x);
+			
+			static void setBatchQuaternion(const ::rl::math::ConstMatrixRef& q, Batch& x);
+			
+			static void setBatchRotation(const ::rl::math::Vector3& axis, const ::Eigen::Array<::rl::math::Real, 1, ::Eigen::Dynamic>& angle, Batch& x);
+			
+			static void setBatchTranslation(const ::rl::math::Vector3& translation, Batch& x);
 			
 		private:
 			
@@ -25,14 +25,19 @@
 //
 
 #include <algorithm>
+#include <limits>
 #include <stack>
+#include <unordered_map>
 #include <boost/graph/graphviz.hpp>
 #include <rl/math/Quaternion.h>
 #include <rl/math/Rotation.h>
 #include <rl/math/Spatial.h>
 #include <rl/math/Unit.h>
 
+#include "Body.h"
 #include "Exception.h"
+#include "Frame.h"
+#include "Joint.h"
 #include "Kinematic.h"
 #include "Prismatic.h"
 #include "Revolute.h"
@@ -43,9 +48,20 @@ namespace rl
 	{
 		Kinematic::Kinematic() :
 			Metric(),
+			bodyTransforms(),
+			ends(),
+			indices(),
 			invJ(),
 			J(),
-			Jdqd()
+			Jdqd(),
+			offsets(),
+			parents(),
+			tips(),
+			batch(),
+			batches(),
+			revision(0),
+			revisions(),
+			worldRevision(0)
 		{
 		}
 		
@@ -65,32 +81,44 @@ namespace rl
 			assert(J.rows() == this->getOperationalDof() * 6);
 			assert(J.cols() == this->getDof());
 			
-			::rl::math::Vector tmp(this->getDof());
+			::std::size_t npos = ::std::numeric_limits<::std::size_t>::max();
 			
-			for (::std::size_t i = 0; i < this->getDof(); ++i)
+			J.setZero();
+			
+			for (::std::size_t j = 0; j < this->getOperationalDof(); ++j)
 			{
-				for (::std::size_t j = 0; j < this->getDof(); ++j)
-				{
-					tmp(j) = i == j ? 1 : 0;
-				}
-				
-				this->setVelocity(tmp);
-				this->forwardVelocity();
+				// motion transform from current frame to operational frame
+				::rl::math::PlueckerTransform x = ::rl::math::PlueckerTransform::Identity();
 				
-				for (::std::size_t j = 0; j < this->getOperationalDof(); ++j)
+				for (::std::size_t i = this->tips[j]; npos != i; i = this->parents[i])
 				{
-					if (inWorldFrame)
+					if (npos != this->indices[i])
 					{
-						J.block(j * 6, i, 3, 1) = this->getOperationalPosition(j).linear() * this->getOperationalVelocity(j).linear();
-						J.block(j * 6 + 3, i, 3, 1) = this->getOperationalPosition(j).linear() * this->getOperationalVelocity(j).angular();
-					}
-					else
-					{
-						J.block(j * 6, i, 3, 1) = this->getOperationalVelocity(j).linear();
-						J.block(j * 6 + 3, i, 3, 1) = this->getOperationalVelocity(j).angular();
+						Joint* joint = this->joints[this->indices[i]];
+						
+						// X * S
+						::Eigen::Matrix<::rl::math::Real, 6, ::Eigen::Dynamic, ::Eigen::ColMajor, 6, 6> xS = x.matrixMotion() * joint->S;
+						
+						if (inWorldFrame)
+						{
+							J.block(j * 6, this->offsets[i], 3, joint->getDof()) = this->getOperationalPosition(j).linear() * xS.bottomRows(3);
+							J.block(j * 6 + 3, this->offsets[i], 3, joint->getDof()) = this->getOperationalPosition(j).linear() * xS.topRows(3);
+						}
+						else
+						{
+							J.block(j * 6, this->offsets[i], 3, joint->getDof()) = xS.bottomRows(3);
+							J.block(j * 6 + 3, this->offsets[i], 3, joint->getDof()) = xS.topRows(3);
+						}
 					}
+					
+					x = this->transforms[i]->x * x;
 				}
 			}
+			
+			if (!this->gammaVelocityIdentity)
+			{
+				J = J * this->gammaVelocity;
+			}
 		}
 		
 		void
@@ -102,11 +130,31 @@ namespace rl
 		void
 		Kinematic::calculateJacobianDerivative(::rl::math::Vector& Jdqd, const bool& inWorldFrame)
 		{
-			::rl::math::Vector tmp = ::rl::math::Vector::Zero(this->getDof());
+			::std::size_t npos = ::std::numeric_limits<::std::size_t>::max();
+			
+			this->tree[this->root]->a.setZero();
 			
-			this->setAcceleration(tmp);
-			this->forwardVelocity();
-			this->forwardAcceleration();
+			// forward velocity and acceleration with zero joint acceleration
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
+			{
+				Transform* transform = this->transforms[i];
+				
+				if (npos != this->indices[i])
+				{
+					Joint* joint = this->joints[this->indices[i]];
+					// X * v + vj
+					transform->out->v = transform->x * transform->in->v + joint->v;
+					// X * a + cj + v x vj
+					transform->out->a = transform->x * transform->in->a + joint->c + transform->out->v.cross(joint->v);
+				}
+				else
+				{
+					// X * v
+					transform->out->v = transform->x * transform->in->v;
+					// X * a
+					transform->out->a = transform->x * transform->in->a;
+				}
+			}
 			
 			for (::std::size_t j = 0; j < this->getOperationalDof(); ++j)
 			{
@@ -171,6 +219,12 @@ namespace rl
 			return ::std::sqrt((J * J.transpose()).determinant());
 		}
 		
+		Kinematic*
+		Kinematic::clone() const
+		{
+			return new Kinematic(*this);
+		}
+		
 		void
 		Kinematic::forwardAcceleration()
 		{
@@ -183,9 +237,78 @@ namespace rl
 		void
 		Kinematic::forwardPosition()
 		{
-			for (::std::vector<Element*>::iterator i = this->elements.begin(); i != this->elements.end(); ++i)
+			::std::size_t npos = ::std::numeric_limits<::std::size_t>::max();
+			
+			++this->revision;
+			
+			for (::std::size_t i = 0; i < this->transforms.size(); ++i)
+			{
+				// changed joint or recalculated parent frame
+				if (this->transformsChanged || (npos != this->indices[i] && this->positionChanged[this->indices[i]]) || (npos != this->parents[i] && this->revision == this->revisions[this->parents[i]]))
+				{
+					this->transforms[i]->forwardPosition();
+					this->revisions[i] = this->revision;
+				}
+			}
+			
+			if (this->transformsChanged)
+			{
+				this->worldRevision = this->revision;
+			}
+			
+			::std::fill(this->positionChanged.begin(), this->positionChanged.end(), false);
+			this->transformsChanged = false;
+		}
+		
+		void
+		Kinematic::forwardPosition(const ::rl::math::ConstMatrixRef& y)
+		{
+			::std::size_t npos = ::std::numeric_limits<::std::size_t>::max();
+			::rl::math::Matrix gammaY;
+			
+			if (!this->gammaPositionIdentity)
+			{
+				gammaY.noalias() = this->gammaPosition * y;
+			}
+			
+			::rl::math::ConstMatrixRef q = this->gammaPositionIdentity ? y : ::rl::math::ConstMatrixRef(gammaY);
+			
+			for (::std::size_t i = 0, j = 0; i < this->transforms.size(); ++i)
 			{
-				(*i)->forwardPosition();
+				if (npos != this->indices[i])
+				{
+					Joint* joint = this->joints[this->indices[i]];
+					joint->calculateBatch(q.middleRows(j, joint->getDofPosition()), this->batch);
+					j += joint->getDofPosition();
+					
+					if (npos != this->parents[i])
+					{
+						Kinematic::multiplyBatch(this->batches[this->parents[i]], this->batch, this->batches[i]);
+					}
+					else
+					{
+						Kinematic::multiplyBatch(this->transforms[i]->in->x.transform(), this->batch, this->batches[i]);
+					}
+				}
+				else if (npos != this->parents[i])
+				{
+					Kinematic::multiplyBatch(this->batches[this->parents[i]], this->transforms[i]->x.transform(), this->batches[i]);
+				}
+				else
+				{
+					::rl::math::Transform x = this->transforms[i]->in->x.transform() * this->transforms[i]->x.transform();
+					this->batches[i].resize(12, q.cols());
+					
+					for (::std::size_t k = 0; k < 3; ++k)
+					{
+						for (::std::size_t l = 0; l < 3; ++l)
+						{
+							this->batches[i].row(3 * k + l).setConstant(x.linear()(l, k));
+						}
+						
+						this->batches[i].row(9 + k).setConstant(x.translation()(k));
+					}
+				}
 			}
 		}
 		
@@ -198,6 +321,63 @@ namespace rl
 			}
 		}
 		
+		::rl::math::Transform
+		Kinematic::getBatch(const Joint::Batch& x, const ::std::size_t& j)
+		{
+			::rl::math::Transform t;
+			
+			for (::std::size_t k = 0; k < 3; ++k)
+			{
+				for (::std::size_t l = 0; l < 3; ++l)
+				{
+					t.linear()(l, k) = x(3 * k + l, j);
+				}
+				
+				t.translation()(k) = x(9 + k, j);
+			}
+			
+			t.makeAffine();
+			
+			return t;
+		}
+		
+		::rl::math::Transform
+		Kinematic::getBatchBodyFrame(const ::std::size_t& i, const ::std::size_t& j) const
+		{
+			assert(i < this->getBodies());
+			
+			if (::std::numeric_limits<::std::size_t>::max() == this->bodyTransforms[i])
+			{
+				return this->bodies[i]->x.transform();
+			}
+			
+			assert(j < static_cast<::std::size_t>(this->batches[this->bodyTransforms[i]].cols()));
+			
+			return Kinematic::getBatch(this->batches[this->bodyTransforms[i]], j);
+		}
+		
+		::rl::math::Transform
+		Kinematic::getBatchOperationalPosition(const ::std::size_t& i, const ::std::size_t& j) const
+		{
+			assert(i < this->getOperationalDof());
+			assert(j < static_cast<::std::size_t>(this->batches[this->tips[i]].cols()));
+			
+			return Kinematic::getBatch(this->batches[this->tips[i]], j);
+		}
+		
+		::std::size_t
+		Kinematic::getBodyFrameRevision(const ::std::size_t& i) const
+		{
+			assert(i < this->bodies.size());
+			
+			if (::std::numeric_limits<::std::size_t>::max() == this->bodyTransforms[i])
+			{
+				return this->worldRevision;
+			}
+			
+			return this->revisions[this->bodyTransforms[i]];
+		}
+		
 		const ::rl::math::Matrix&
 		Kinematic::getJacobian() const
 		{
@@ -229,11 +409,131 @@ namespace rl
 			return (::std::abs(svd.singularValues()(svd.singularValues().size() - 1)) > ::std::numeric_limits<::rl::math::Real>::epsilon()) ? false : true;
 		}
 		
+		void
+		Kinematic::multiplyBatch(const Joint::Batch& a, const Joint::Batch& b, Joint::Batch& c)
+		{
+			c.resize(12, b.cols());
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				for (::std::size_t j = 0; j < 3; ++j)
+				{
+					c.row(3 * j + i) = a.row(i) * b.row(3 * j) + a.row(3 + i) * b.row(3 * j + 1) + a.row(6 + i) * b.row(3 * j + 2);
+				}
+				
+				c.row(9 + i) = a.row(i) * b.row(9) + a.row(3 + i) * b.row(10) + a.row(6 + i) * b.row(11) + a.row(9 + i);
+			}
+		}
+		
+		void
+		Kinematic::multiplyBatch(const Joint::Batch& a, const ::rl::math::Transform& b, Joint::Batch& c)
+		{
+			c.resize(12, a.cols());
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				for (::std::size_t j = 0; j < 3; ++j)
+				{
+					c.row(3 * j + i) = a.row(i) * b.linear()(0, j) + a.row(3 + i) * b.linear()(1, j) + a.row(6 + i) * b.linear()(2, j);
+				}
+				
+				c.row(9 + i) = a.row(i) * b.translation()(0) + a.row(3 + i) * b.translation()(1) + a.row(6 + i) * b.translation()(2) + a.row(9 + i);
+			}
+		}
+		
+		void
+		Kinematic::multiplyBatch(const ::rl::math::Transform& a, const Joint::Batch& b, Joint::Batch& c)
+		{
+			c.resize(12, b.cols());
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				for (::std::size_t j = 0; j < 3; ++j)
+				{
+					c.row(3 * j + i) = a.linear()(i, 0) * b.row(3 * j) + a.linear()(i, 1) * b.row(3 * j + 1) + a.linear()(i, 2) * b.row(3 * j + 2);
+				}
+				
+				c.row(9 + i) = a.linear()(i, 0) * b.row(9) + a.linear()(i, 1) * b.row(10) + a.linear()(i, 2) * b.row(11) + a.translation()(i);
+			}
+		}
+		
+		void
+		Kinematic::touchBodyFrames()
+		{
+			++this->revision;
+			
+			::std::fill(this->revisions.begin(), this->revisions.end(), this->revision);
+			this->worldRevision = this->revision;
+			
+			::std::fill(this->positionChanged.begin(), this->positionChanged.end(), false);
+			this->transformsChanged = false;
+		}
+		
 		void
 		Kinematic::update()
 		{
 			Metric::update();
 			
+			::std::size_t npos = ::std::numeric_limits<::std::size_t>::max();
+			::std::unordered_map<const Frame*, ::std::size_t> outs;
+			
+			this->ends.assign(this->transforms.size(), 0);
+			this->indices.assign(this->transforms.size(), npos);
+			this->offsets.assign(this->transforms.size(), 0);
+			this->parents.assign(this->transforms.size(), npos);
+			
+			// transforms are in depth-first order, parents precede their children
+			for (::std::size_t i = 0, j = 0, k = 0; i < this->transforms.size(); ++i)
+			{
+				::std::unordered_map<const Frame*, ::std::size_t>::const_iterator parent = outs.find(this->transforms[i]->in);
+				
+				if (outs.end() != parent)
+				{
+					this->parents[i] = parent->second;
+				}
+				
+				outs[this->transforms[i]->out] = i;
+				this->offsets[i] = j;
+				
+				if (k < this->joints.size() && this->joints[k] == this->transforms[i])
+				{
+					this->indices[i] = k;
+					j += this->joints[k]->getDof();
+					++k;
+				}
+				
+				this->ends[i] = j;
+			}
+			
+			for (::std::size_t i = this->transforms.size(); i-- > 0;)
+			{
+				if (npos != this->parents[i])
+				{
+					this->ends[this->parents[i]] = ::std::max(this->ends[this->parents[i]], this->ends[i]);
+				}
+			}
+			
+			this->bodyTransforms.assign(this->bodies.size(), npos);
+			
+			for (::std::size_t i = 0; i < this->bodies.size(); ++i)
+			{
+				::std::unordered_map<const Frame*, ::std::size_t>::const_iterator transform = outs.find(this->bodies[i]);
+				
+				if (outs.end() != transform)
+				{
+					this->bodyTransforms[i] = transform->second;
+				}
+			}
+			
+			this->batches.resize(this->transforms.size());
+			this->revisions.assign(this->transforms.size(), this->revision);
+			this->tips.resize(this->tools.size());
+			
+			for (::std::size_t i = 0; i < this->tools.size(); ++i)
+			{
+				this->tips[i] = outs[this->tree[this->tools[i]]->out];
+			}
+			
 			this->invJ = ::rl::math::Matrix::Identity(this->getDof(), 6 * this->getOperationalDof());
 			this->J = ::rl::math::Matrix::Identity(6 * this->getOperationalDof(), this->getDof());
 			this->Jdqd = ::rl::math::Vector::Zero(6 * this->getOperationalDof());
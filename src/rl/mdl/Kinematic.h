@@ -27,8 +27,10 @@
 #ifndef RL_MDL_KINEMATIC_H
 #define RL_MDL_KINEMATIC_H
 
+#include <vector>
 #include <rl/math/Matrix.h>
 
+#include "Joint.h"
 #include "Metric.h"
 
 namespace rl
@@ -66,7 +68,7 @@ namespace rl
 			 *
 			 * @see forwardVelocity()
 			 */
-			void calculateJacobian(::rl::math::Matrix& J, const bool& inWorldFrame = true);
+			virtual void calculateJacobian(::rl::math::Matrix& J, const bool& inWorldFrame = true);
 			
 			/**
 			 * Calculate Jacobian derivative vector.
@@ -150,6 +152,8 @@ namespace rl
 			 */
 			::rl::math::Real calculateManipulabilityMeasure(const ::rl::math::Matrix& J) const;
 			
+			Kinematic* clone() const;
+			
 			/**
 			 * @pre setPosition()
 			 * @pre setVelocity()
@@ -159,10 +163,30 @@ namespace rl
 			void forwardAcceleration();
 			
 			/**
+			 * Only transforms below joints with a modified position since the last
+			 * call are recalculated, all after update(), tool() or world() access.
+			 * Call update() after modifying other transforms directly.
+			 *
 			 * @pre setPosition()
 			 * @post getOperationalPosition()
+			 * @post getBodyFrameRevision()
+			 */
+			virtual void forwardPosition();
+			
+			/**
+			 * Calculate frames for a batch of joint positions.
+			 *
+			 * All configurations are propagated through the kinematic tree at once,
+			 * with intermediate frames stored in structure-of-arrays layout, which
+			 * allows vectorizing the computation across configurations.
+			 * The joint state of the model is not modified.
+			 *
+			 * @param[in] y Joint positions, one configuration per column
+			 *
+			 * @post getBatchBodyFrame()
+			 * @post getBatchOperationalPosition()
 			 */
-			void forwardPosition();
+			void forwardPosition(const ::rl::math::ConstMatrixRef& y);
 			
 			/**
 			 * @pre setPosition()
@@ -171,6 +195,38 @@ namespace rl
 			 */
 			void forwardVelocity();
 			
+			/**
+			 * Access body frame of a batch configuration.
+			 *
+			 * @param[in] i Body index
+			 * @param[in] j Configuration index
+			 *
+			 * @pre forwardPosition(const ::rl::math::ConstMatrixRef&)
+			 */
+			::rl::math::Transform getBatchBodyFrame(const ::std::size_t& i, const ::std::size_t& j) const;
+			
+			/**
+			 * Access operational position of a batch configuration.
+			 *
+			 * @param[in] i Operational frame index
+			 * @param[in] j Configuration index
+			 *
+			 * @pre forwardPosition(const ::rl::math::ConstMatrixRef&)
+			 */
+			::rl::math::Transform getBatchOperationalPosition(const ::std::size_t& i, const ::std::size_t& j) const;
+			
+			/**
+			 * Revision of body frame for detecting modifications.
+			 *
+			 * Changes whenever forwardPosition() recalculates the body frame.
+			 * Overriding implementations of forwardPosition() have to call
+			 * touchBodyFrames(). Modifying frames or transforms directly does not
+			 * change it before the next update().
+			 *
+			 * @param[in] i Body index
+			 */
+			::std::size_t getBodyFrameRevision(const ::std::size_t& i) const;
+			
 			/**
 			 * Access calculated Jacobian matrix.
 			 *
@@ -220,6 +276,31 @@ namespace rl
 			virtual void update();
 			
 		protected:
+			/**
+			 * Mark all body frames as recalculated.
+			 *
+			 * For implementations of forwardPosition() that do not use the
+			 * recalculation of modified subtrees.
+			 *
+			 * @post getBodyFrameRevision()
+			 */
+			void touchBodyFrames();
+			
+			/**
+			 * Index of the transform leading to each body, maximum value if not attached to a transform.
+			 */
+			::std::vector<::std::size_t> bodyTransforms;
+			
+			/**
+			 * Last velocity index plus one in the subtree of each transform.
+			 */
+			::std::vector<::std::size_t> ends;
+			
+			/**
+			 * Index into joints for each transform, maximum value if not a joint.
+			 */
+			::std::vector<::std::size_t> indices;
+			
 			/**
 			 * Jacobian matrix inverse.
 			 *
@@ -253,8 +334,54 @@ namespace rl
 			 * */
 			::rl::math::Vector Jdqd;
 			
+			/**
+			 * First velocity index in the subtree of each transform.
+			 */
+			::std::vector<::std::size_t> offsets;
+			
+			/**
+			 * Index of the parent transform, maximum value if attached to the root.
+			 */
+			::std::vector<::std::size_t> parents;
+			
+			/**
+			 * Index of the transform leading to each operational frame.
+			 */
+			::std::vector<::std::size_t> tips;
+			
 		private:
+			static ::rl::math::Transform getBatch(const Joint::Batch& x, const ::std::size_t& j);
+			
+			static void multiplyBatch(const Joint::Batch& a, const Joint::Batch& b, Joint::Batch& c);
+			
+			static void multiplyBatch(const Joint::Batch& a, const ::rl::math::Transform& b, Joint::Batch& c);
 			
+			static void multiplyBatch(const ::rl::math::Transform& a, const Joint::Batch& b, Joint::Batch& c);
+			
+			/**
+			 * Joint transforms of the current batch.
+			 */
+			Joint::Batch batch;
+			
+			/**
+			 * Frames of the current batch at the output of each transform.
+			 */
+			::std::vector<Joint::Batch> batches;
+			
+			/**
+			 * Number of forward position calculations.
+			 */
+			::std::size_t revision;
+			
+			/**
+			 * Forward position calculation that last recalculated each transform.
+			 */
+			::std::vector<::std::size_t> revisions;
+			
+			/**
+			 * Forward position calculation that last recalculated all transforms.
+			 */
+			::std::size_t worldRevision;
 		};
 	}
 }
@@ -51,6 +51,12 @@ namespace rl
 			}
 		}
 		
+		Metric*
+		Metric::clone() const
+		{
+			return new Metric(*this);
+		}
+		
 		::rl::math::Real
 		Metric::distance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const
 		{
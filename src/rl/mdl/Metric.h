@@ -42,7 +42,7 @@ namespace rl
 			
 			void clamp(::rl::math::Vector& q) const;
 			
-			Model* clone() const;
+			Metric* clone() const;
 			
 			::rl::math::Real distance(const ::rl::math::Vector& q1, const ::rl::math::Vector& q2) const;
 			
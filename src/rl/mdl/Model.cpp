@@ -24,6 +24,8 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <unordered_map>
+
 #include "Body.h"
 #include "Compound.h"
 #include "Exception.h"
@@ -40,7 +42,9 @@ namespace rl
 			elements(),
 			frames(),
 			gammaPosition(),
+			gammaPositionIdentity(true),
 			gammaVelocity(),
+			gammaVelocityIdentity(true),
 			home(),
 			invGammaPosition(),
 			invGammaVelocity(),
@@ -48,13 +52,88 @@ namespace rl
 			leaves(),
 			manufacturer(),
 			name(),
+			positionChanged(),
 			root(0),
 			tools(),
 			transforms(),
+			transformsChanged(true),
 			tree(),
 			randDistribution(0, 1),
-			randEngine(::std::random_device()())
+			randEngine(::std::random_device()()),
+			workspacePosition(),
+			workspaceVelocity()
+		{
+		}
+		
+		Model::Model(const Model& other) :
+			bodies(),
+			elements(),
+			frames(),
+			gammaPosition(),
+			gammaPositionIdentity(true),
+			gammaVelocity(),
+			gammaVelocityIdentity(true),
+			home(),
+			invGammaPosition(),
+			invGammaVelocity(),
+			joints(),
+			leaves(),
+			manufacturer(other.manufacturer),
+			name(other.name),
+			positionChanged(),
+			root(0),
+			tools(),
+			transforms(),
+			transformsChanged(true),
+			tree(),
+			randDistribution(other.randDistribution),
+			randEngine(::std::random_device()()),
+			workspacePosition(other.workspacePosition),
+			workspaceVelocity(other.workspaceVelocity)
 		{
+			::std::unordered_map<const Frame*, Frame*> copies;
+			
+			for (VertexIteratorPair i = ::boost::vertices(other.tree); i.first != i.second; ++i.first)
+			{
+				Frame* frame = other.tree[*i.first]->clone();
+				frame->compound = nullptr;
+				this->add(frame);
+				copies[other.tree[*i.first].get()] = frame;
+			}
+			
+			for (EdgeIteratorPair i = ::boost::edges(other.tree); i.first != i.second; ++i.first)
+			{
+				Transform* transform = other.tree[*i.first]->clone();
+				transform->compound = nullptr;
+				this->add(
+					transform,
+					copies[other.tree[::boost::source(*i.first, other.tree)].get()],
+					copies[other.tree[::boost::target(*i.first, other.tree)].get()]
+				);
+			}
+			
+			if (0 != this->root)
+			{
+				this->update();
+			}
+			
+			for (::std::size_t i = 0; i < this->bodies.size(); ++i)
+			{
+				this->bodies[i]->selfcollision.clear();
+				
+				for (::std::unordered_set<Body*>::const_iterator j = other.bodies[i]->selfcollision.begin(); j != other.bodies[i]->selfcollision.end(); ++j)
+				{
+					this->bodies[i]->selfcollision.insert(static_cast<Body*>(copies[*j]));
+				}
+			}
+			
+			this->gammaPosition = other.gammaPosition;
+			this->gammaPositionIdentity = other.gammaPositionIdentity;
+			this->gammaVelocity = other.gammaVelocity;
+			this->gammaVelocityIdentity = other.gammaVelocityIdentity;
+			this->home = other.home;
+			this->invGammaPosition = other.invGammaPosition;
+			this->invGammaVelocity = other.invGammaVelocity;
 		}
 		
 		Model::~Model()
@@ -108,6 +187,12 @@ namespace rl
 			}
 		}
 		
+		Model*
+		Model::clone() const
+		{
+			return new Model(*this);
+		}
+		
 		::rl::math::Vector
 		Model::generatePositionGaussian(const ::rl::math::Vector& mean, const ::rl::math::Vector& sigma)
 		{
@@ -202,14 +287,32 @@ namespace rl
 		::rl::math::Vector
 		Model::getAcceleration() const
 		{
-			::rl::math::Vector qdd(this->getDof());
+			::rl::math::Vector ydd(this->getDof());
+			this->getAcceleration(ydd);
+			return ydd;
+		}
+		
+		void
+		Model::getAcceleration(::rl::math::Vector& ydd) const
+		{
+			ydd.resize(this->getDof());
 			
-			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+			if (this->gammaVelocityIdentity)
 			{
-				qdd.segment(j, this->joints[i]->getDof()) = this->joints[i]->getAcceleration();
+				for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+				{
+					ydd.segment(j, this->joints[i]->getDof()) = this->joints[i]->getAcceleration();
+				}
+			}
+			else
+			{
+				ydd.setZero();
+				
+				for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+				{
+					ydd.noalias() += this->invGammaVelocity.middleCols(j, this->joints[i]->getDof()) * this->joints[i]->getAcceleration();
+				}
 			}
-			
-			return this->invGammaVelocity * qdd;
 		}
 		
 		::Eigen::Matrix<::rl::math::Unit, ::Eigen::Dynamic, 1>
@@ -379,26 +482,38 @@ namespace rl
 		Model::getMaximum() const
 		{
 			::rl::math::Vector max(this->getDofPosition());
+			this->getMaximum(max);
+			return max;
+		}
+		
+		void
+		Model::getMaximum(::rl::math::Vector& max) const
+		{
+			max.resize(this->getDofPosition());
 			
 			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDofPosition(), ++i)
 			{
 				max.segment(j, this->joints[i]->getDofPosition()) = this->joints[i]->getMaximum();
 			}
-			
-			return max;
 		}
 		
 		::rl::math::Vector
 		Model::getMinimum() const
 		{
 			::rl::math::Vector min(this->getDofPosition());
+			this->getMinimum(min);
+			return min;
+		}
+		
+		void
+		Model::getMinimum(::rl::math::Vector& min) const
+		{
+			min.resize(this->getDofPosition());
 			
 			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDofPosition(), ++i)
 			{
 				min.segment(j, this->joints[i]->getDofPosition()) = this->joints[i]->getMinimum();
 			}
-			
-			return min;
 		}
 		
 		const ::std::string&
@@ -410,14 +525,32 @@ namespace rl
 		::rl::math::Vector
 		Model::getPosition() const
 		{
-			::rl::math::Vector q(this->getDofPosition());
+			::rl::math::Vector y(this->getDofPosition());
+			this->getPosition(y);
+			return y;
+		}
+		
+		void
+		Model::getPosition(::rl::math::Vector& y) const
+		{
+			y.resize(this->getDofPosition());
 			
-			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDofPosition(), ++i)
+			if (this->gammaPositionIdentity)
 			{
-				q.segment(j, this->joints[i]->getDofPosition()) = this->joints[i]->getPosition();
+				for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDofPosition(), ++i)
+				{
+					y.segment(j, this->joints[i]->getDofPosition()) = this->joints[i]->getPosition();
+				}
+			}
+			else
+			{
+				y.setZero();
+				
+				for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDofPosition(), ++i)
+				{
+					y.noalias() += this->invGammaPosition.middleCols(j, this->joints[i]->getDofPosition()) * this->joints[i]->getPosition();
+				}
 			}
-			
-			return this->invGammaPosition * q;
 		}
 		
 		::Eigen::Matrix<::rl::math::Unit, ::Eigen::Dynamic, 1>
@@ -437,13 +570,19 @@ namespace rl
 		Model::getSpeed() const
 		{
 			::rl::math::Vector speed(this->getDof());
+			this->getSpeed(speed);
+			return speed;
+		}
+		
+		void
+		Model::getSpeed(::rl::math::Vector& speed) const
+		{
+			speed.resize(this->getDof());
 			
 			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
 			{
 				speed.segment(j, this->joints[i]->getDof()) = this->joints[i]->getSpeed();
 			}
-			
-			return speed;
 		}
 		
 		::Eigen::Matrix<::rl::math::Unit, ::Eigen::Dynamic, 1>
@@ -463,13 +602,19 @@ namespace rl
 		Model::getTorque() const
 		{
 			::rl::math::Vector tau(this->getDof());
+			this->getTorque(tau);
+			return tau;
+		}
+		
+		void
+		Model::getTorque(::rl::math::Vector& tau) const
+		{
+			tau.resize(this->getDof());
 			
 			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
 			{
 				tau.segment(j, this->joints[i]->getDof()) = this->joints[i]->getTorque();
 			}
-			
-			return tau;
 		}
 		
 		::Eigen::Matrix<::rl::math::Unit, ::Eigen::Dynamic, 1>
@@ -502,14 +647,32 @@ namespace rl
 		::rl::math::Vector
 		Model::getVelocity() const
 		{
-			::rl::math::Vector qd(this->getDof());
+			::rl::math::Vector yd(this->getDof());
+			this->getVelocity(yd);
+			return yd;
+		}
+		
+		void
+		Model::getVelocity(::rl::math::Vector& yd) const
+		{
+			yd.resize(this->getDof());
 			
-			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+			if (this->gammaVelocityIdentity)
+			{
+				for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+				{
+					yd.segment(j, this->joints[i]->getDof()) = this->joints[i]->getVelocity();
+				}
+			}
+			else
 			{
-				qd.segment(j, this->joints[i]->getDof()) = this->joints[i]->getVelocity();
+				yd.setZero();
+				
+				for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+				{
+					yd.noalias() += this->invGammaVelocity.middleCols(j, this->joints[i]->getDof()) * this->joints[i]->getVelocity();
+				}
 			}
-			
-			return this->invGammaVelocity * qd;
 		}
 		
 		::Eigen::Matrix<::rl::math::Unit, ::Eigen::Dynamic, 1>
@@ -613,11 +776,21 @@ namespace rl
 		void
 		Model::setAcceleration(const ::rl::math::Vector& ydd)
 		{
-			::rl::math::Vector qdd = this->gammaVelocity * ydd;
-			
-			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+			if (this->gammaVelocityIdentity)
 			{
-				this->joints[i]->setAcceleration(qdd.segment(j, this->joints[i]->getDof()));
+				for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+				{
+					this->joints[i]->setAcceleration(ydd.segment(j, this->joints[i]->getDof()));
+				}
+			}
+			else
+			{
+				this->workspaceVelocity.noalias() = this->gammaVelocity * ydd;
+				
+				for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+				{
+					this->joints[i]->setAcceleration(this->workspaceVelocity.segment(j, this->joints[i]->getDof()));
+				}
 			}
 		}
 		
@@ -625,6 +798,7 @@ namespace rl
 		Model::setGammaPosition(const ::rl::math::Matrix& gammaPosition)
 		{
 			this->gammaPosition = gammaPosition;
+			this->gammaPositionIdentity = this->gammaPosition.isIdentity();
 			::Eigen::JacobiSVD<::rl::math::Matrix> svd(this->gammaPosition, ::Eigen::ComputeThinU | ::Eigen::ComputeThinV);
 			::rl::math::Vector singularValues(svd.singularValues().size());
 			
@@ -640,6 +814,7 @@ namespace rl
 		Model::setGammaVelocity(const ::rl::math::Matrix& gammaVelocity)
 		{
 			this->gammaVelocity = gammaVelocity;
+			this->gammaVelocityIdentity = this->gammaVelocity.isIdentity();
 			::Eigen::JacobiSVD<::rl::math::Matrix> svd(this->gammaVelocity, ::Eigen::ComputeThinU | ::Eigen::ComputeThinV);
 			::rl::math::Vector singularValues(svd.singularValues().size());
 			
@@ -678,11 +853,21 @@ namespace rl
 		void
 		Model::setPosition(const ::rl::math::Vector& y)
 		{
-			::rl::math::Vector q = this->gammaPosition * y;
+			const ::rl::math::Vector& q = this->gammaPositionIdentity ? y : this->workspacePosition;
+			
+			if (!this->gammaPositionIdentity)
+			{
+				this->workspacePosition.noalias() = this->gammaPosition * y;
+			}
 			
 			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDofPosition(), ++i)
 			{
-				this->joints[i]->setPosition(q.segment(j, this->joints[i]->getDofPosition()));
+				// unchanged joints keep their transform for forward position
+				if (this->positionChanged[i] || q.segment(j, this->joints[i]->getDofPosition()) != this->joints[i]->getPosition())
+				{
+					this->joints[i]->setPosition(q.segment(j, this->joints[i]->getDofPosition()));
+					this->positionChanged[i] = true;
+				}
 			}
 		}
 		
@@ -698,11 +883,21 @@ namespace rl
 		void
 		Model::setVelocity(const ::rl::math::Vector& yd)
 		{
-			::rl::math::Vector qd = this->gammaVelocity * yd;
-			
-			for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+			if (this->gammaVelocityIdentity)
 			{
-				this->joints[i]->setVelocity(qd.segment(j, this->joints[i]->getDof()));
+				for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+				{
+					this->joints[i]->setVelocity(yd.segment(j, this->joints[i]->getDof()));
+				}
+			}
+			else
+			{
+				this->workspaceVelocity.noalias() = this->gammaVelocity * yd;
+				
+				for (::std::size_t i = 0, j = 0; i < this->joints.size(); j += this->joints[i]->getDof(), ++i)
+				{
+					this->joints[i]->setVelocity(this->workspaceVelocity.segment(j, this->joints[i]->getDof()));
+				}
 			}
 		}
 		
@@ -717,6 +912,8 @@ namespace rl
 		{
 			assert(i < this->tools.size());
 			
+			this->transformsChanged = true;
+			
 			return this->tree[this->tools[i]]->x.transform();
 		}
 		
@@ -785,15 +982,23 @@ namespace rl
 			}
 			
 			this->gammaPosition = ::rl::math::Matrix::Identity(this->getDofPosition(), this->getDofPosition());
+			this->gammaPositionIdentity = true;
 			this->gammaVelocity = ::rl::math::Matrix::Identity(this->getDof(), this->getDof());
+			this->gammaVelocityIdentity = true;
 			this->home = ::rl::math::Vector::Zero(this->getDofPosition());
 			this->invGammaPosition = ::rl::math::Matrix::Identity(this->getDofPosition(), this->getDofPosition());
 			this->invGammaVelocity = ::rl::math::Matrix::Identity(this->getDof(), this->getDof());
+			this->positionChanged.assign(this->joints.size(), true);
+			this->transformsChanged = true;
+			this->workspacePosition.resize(this->getDofPosition());
+			this->workspaceVelocity.resize(this->getDof());
 		}
 		
 		::rl::math::Transform&
 		Model::world()
 		{
+			this->transformsChanged = true;
+			
 			return this->tree[this->root]->x.transform();
 		}
 		
@@ -59,6 +59,15 @@ namespace rl
 		public:
 			Model();
 			
+			/**
+			 * Deep copy of kinematic structure and state.
+			 *
+			 * All frames and transforms are duplicated, so that the copy can be
+			 * used independently of the original, e.g., in a different thread.
+			 * Compounds are not copied.
+			 */
+			Model(const Model& other);
+			
 			virtual ~Model();
 			
 			void add(Compound* compound, const Frame* a, const Frame* b);
@@ -69,6 +78,8 @@ namespace rl
 			
 			bool areColliding(const ::std::size_t& i, const ::std::size_t& j) const;
 			
+			virtual Model* clone() const;
+			
 			::rl::math::Vector generatePositionGaussian(const ::rl::math::Vector& mean, const ::rl::math::Vector& sigma);
 			
 			::rl::math::Vector generatePositionGaussian(const ::rl::math::Vector& rand, const ::rl::math::Vector& mean, const ::rl::math::Vector& sigma) const;
@@ -83,6 +94,8 @@ namespace rl
 			
 			::rl::math::Vector getAcceleration() const;
 			
+			void getAcceleration(::rl::math::Vector& ydd) const;
+			
 			::Eigen::Matrix<::rl::math::Unit, ::Eigen::Dynamic, 1> getAccelerationUnits() const;
 			
 			::std::size_t getBodies() const;
@@ -127,12 +140,18 @@ namespace rl
 			
 			::rl::math::Vector getMaximum() const;
 			
+			void getMaximum(::rl::math::Vector& max) const;
+			
 			::rl::math::Vector getMinimum() const;
 			
+			void getMinimum(::rl::math::Vector& min) const;
+			
 			const ::std::string& getName() const;
 			
 			::rl::math::Vector getPosition() const;
 			
+			void getPosition(::rl::math::Vector& y) const;
+			
 			::Eigen::Matrix<::rl::math::Unit, ::Eigen::Dynamic, 1> getPositionUnits() const;
 			
 			Transform* getTransform(const ::std::size_t& i) const;
@@ -141,14 +160,20 @@ namespace rl
 			
 			::rl::math::Vector getSpeed() const;
 			
+			void getSpeed(::rl::math::Vector& speed) const;
+			
 			::Eigen::Matrix<::rl::math::Unit, ::Eigen::Dynamic, 1> getSpeedUnits() const;
 			
 			::rl::math::Vector getTorque() const;
 			
+			void getTorque(::rl::math::Vector& tau) const;
+			
 			::Eigen::Matrix<::rl::math::Unit, ::Eigen::Dynamic, 1> getTorqueUnits() const;
 			
 			::rl::math::Vector getVelocity() const;
 			
+			void getVelocity(::rl::math::Vector& yd) const;
+			
 			::Eigen::Matrix<::rl::math::Unit, ::Eigen::Dynamic, 1> getVelocityUnits() const;
 			
 			World* getWorld() const;
@@ -252,8 +277,18 @@ namespace rl
 			
 			::rl::math::Matrix gammaPosition;
 			
+			/**
+			 * Position gamma matrix is identity, joint positions are copied directly.
+			 */
+			bool gammaPositionIdentity;
+			
 			::rl::math::Matrix gammaVelocity;
 			
+			/**
+			 * Velocity gamma matrix is identity, joint velocities are copied directly.
+			 */
+			bool gammaVelocityIdentity;
+			
 			::rl::math::Vector home;
 			
 			::rl::math::Matrix invGammaPosition;
@@ -268,12 +303,22 @@ namespace rl
 			
 			::std::string name;
 			
+			/**
+			 * Joints with modified position since the last forward position calculation.
+			 */
+			::std::vector<bool> positionChanged;
+			
 			Vertex root;
 			
 			::std::vector<Edge> tools;
 			
 			::std::vector<Transform*> transforms;
 			
+			/**
+			 * Tool or world transform may have been modified, all transforms need recalculation.
+			 */
+			bool transformsChanged;
+			
 			Tree tree;
 			
 		private:
@@ -282,6 +327,16 @@ namespace rl
 			::std::uniform_real_distribution<::rl::math::Real> randDistribution;
 			
 			::std::mt19937 randEngine;
+			
+			/**
+			 * Preallocated joint space vector for setPosition().
+			 */
+			::rl::math::Vector workspacePosition;
+			
+			/**
+			 * Preallocated joint space vector for setAcceleration() and setVelocity().
+			 */
+			::rl::math::Vector workspaceVelocity;
 		};
 	}
 }
@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cmath>
+#include <rl/math/Rotation.h>
+
+#include "Exception.h"
+#include "Kinematic.h"
+#include "OffsetWristInverseKinematics.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		OffsetWristInverseKinematics::OffsetWristInverseKinematics(Kinematic* kinematic) :
+			AnalyticalInverseKinematics(kinematic),
+			center(::rl::math::Vector3::Zero())
+		{
+			this->update();
+		}
+		
+		OffsetWristInverseKinematics::~OffsetWristInverseKinematics()
+		{
+		}
+		
+		bool
+		OffsetWristInverseKinematics::solve()
+		{
+			this->solutions.clear();
+			
+			if (1 != this->goals.size() || 0 != this->goals.front().second)
+			{
+				throw Exception("rl::mdl::OffsetWristInverseKinematics::solve() - Only one goal for operational frame 0 supported");
+			}
+			
+			const ::rl::math::Transform& goal = this->goals.front().first;
+			::rl::math::Vector reference = this->kinematic->getPosition();
+			::rl::math::Vector q(6);
+			
+			const ::rl::math::Vector3& u = this->directions[1];
+			const ::rl::math::Vector3& w4 = this->directions[4];
+			const ::rl::math::Vector3& w5 = this->directions[5];
+			
+			// product of all joint motions
+			::rl::math::Transform g = goal * this->zero.inverse();
+			::rl::math::Vector3 c = g * this->center;
+			
+			// shoulder: intersection of axes 5 and 6 keeps its offset along the rotated axis 2
+			::rl::math::Vector3 r = c - this->points[0];
+			::rl::math::Real q0[2];
+			::std::size_t n0 = calculateAngles(
+				r.dot(u),
+				r.dot(this->directions[0].cross(u)),
+				(this->center - this->points[0]).dot(u),
+				q0
+			);
+			
+			for (::std::size_t i = 0; i < n0; ++i)
+			{
+				::rl::math::Transform g0 = this->calculateRotation(0, q0[i]).inverse() * g;
+				
+				// rotation about axes 2, 3, and 4 preserves components along axis 2
+				::rl::math::Matrix33 m = g0.linear();
+				::rl::math::Real k = w4.dot(w5) * u.dot(w4);
+				::rl::math::Real q4[2];
+				::std::size_t n4 = calculateAngles(u.dot(w5) - k, u.dot(w4.cross(w5)), u.dot(m * w5) - k, q4);
+				
+				for (::std::size_t j = 0; j < n4; ++j)
+				{
+					::rl::math::Matrix33 r4 = ::rl::math::AngleAxis(q4[j], w4).toRotationMatrix();
+					::rl::math::Real q5 = calculateAngle(w5, m.transpose() * u, r4.transpose() * u);
+					::rl::math::Matrix33 r5 = ::rl::math::AngleAxis(q5, w5).toRotationMatrix();
+					
+					// sum of rotations about axes 2, 3, and 4
+					::rl::math::Vector3 x = u.unitOrthogonal();
+					::rl::math::Real phi = calculateAngle(u, x, m * r5.transpose() * r4.transpose() * x);
+					
+					// elbow: planar problem of axes 2 and 3 for a point on axis 4
+					::rl::math::Transform g3 = g0 * (this->calculateRotation(4, q4[j]) * this->calculateRotation(5, q5)).inverse();
+					::rl::math::Real q12[2][2];
+					::std::size_t n12 = this->calculatePlanar(1, this->points[3], g3 * this->points[3], q12);
+					
+					for (::std::size_t l = 0; l < n12; ++l)
+					{
+						::rl::math::Real q3 = phi - q12[l][0] - (this->directions[2].dot(u) > 0 ? q12[l][1] : -q12[l][1]);
+						
+						q << q0[i], q12[l][0], q12[l][1], this->directions[3].dot(u) > 0 ? q3 : -q3, q4[j], q5;
+						this->addSolution(q, reference, goal);
+					}
+				}
+			}
+			
+			return this->finish(reference);
+		}
+		
+		void
+		OffsetWristInverseKinematics::update()
+		{
+			this->updateAxes();
+			
+			if (6 != this->directions.size())
+			{
+				throw Exception("rl::mdl::OffsetWristInverseKinematics::update() - Model with other than six joints");
+			}
+			
+			::rl::math::Real epsilon = static_cast<::rl::math::Real>(1.0e-6);
+			
+			if (::std::abs(this->directions[0].dot(this->directions[1])) > epsilon || this->directions[1].cross(this->directions[2]).norm() > epsilon || this->directions[1].cross(this->directions[3]).norm() > epsilon)
+			{
+				throw Exception("rl::mdl::OffsetWristInverseKinematics::update() - Axis 1 not perpendicular to parallel axes 2, 3, and 4");
+			}
+			
+			if (this->directions[3].cross(this->directions[4]).norm() < epsilon || this->directions[4].cross(this->directions[5]).norm() < epsilon)
+			{
+				throw Exception("rl::mdl::OffsetWristInverseKinematics::update() - Parallel wrist axes");
+			}
+			
+			this->center = this->calculateIntersection(4, 5);
+			
+			if (this->distance(4, this->center) > epsilon || this->distance(5, this->center) > epsilon)
+			{
+				throw Exception("rl::mdl::OffsetWristInverseKinematics::update() - Axes 5 and 6 do not intersect");
+			}
+		}
+	}
+}
@@ -0,0 +1,76 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_MDL_OFFSETWRISTINVERSEKINEMATICS_H
+#define RL_MDL_OFFSETWRISTINVERSEKINEMATICS_H
+
+#include "AnalyticalInverseKinematics.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		/**
+		 * Analytical inverse kinematics for 6R arms with an offset wrist.
+		 *
+		 * Covers arms where axis 1 is perpendicular to the parallel axes 2, 3,
+		 * and 4 and axes 5 and 6 intersect, e.g., Universal Robots arms. Link
+		 * lengths and offsets are extracted from the model in zero
+		 * configuration. solve() returns up to eight solutions for shoulder,
+		 * wrist, and elbow configurations.
+		 */
+		class RL_MDL_EXPORT OffsetWristInverseKinematics : public AnalyticalInverseKinematics
+		{
+		public:
+			/**
+			 * @throws Exception If the model does not match the kinematic structure
+			 */
+			OffsetWristInverseKinematics(Kinematic* kinematic);
+			
+			virtual ~OffsetWristInverseKinematics();
+			
+			/**
+			 * @pre One goal for operational frame 0
+			 */
+			bool solve();
+			
+			/**
+			 * Extract parameters from the kinematic model after modifications.
+			 *
+			 * @throws Exception If the model does not match the kinematic structure
+			 */
+			void update();
+			
+		protected:
+			
+		private:
+			/** Intersection of axes 5 and 6 in zero configuration. */
+			::rl::math::Vector3 center;
+		};
+	}
+}
+
+#endif // RL_MDL_OFFSETWRISTINVERSEKINEMATICS_H
@@ -0,0 +1,237 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "Kinematic.h"
+#include "ParallelInverseKinematics.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		ParallelInverseKinematics::ParallelInverseKinematics(Kinematic* kinematic, const SolverFunction& function, const ::std::size_t& threads) :
+			IterativeInverseKinematics(kinematic),
+			function(function),
+			kinematics(),
+			pool(),
+			randDistribution(0, 1),
+			randEngine(::std::random_device()()),
+			reference(),
+			solutionCount(1),
+			solutions(),
+			solvers(),
+			threads(::std::max<::std::size_t>(threads, 1))
+		{
+		}
+		
+		ParallelInverseKinematics::~ParallelInverseKinematics()
+		{
+		}
+		
+		const ::rl::math::Vector&
+		ParallelInverseKinematics::getReference() const
+		{
+			return this->reference;
+		}
+		
+		const ::std::size_t&
+		ParallelInverseKinematics::getSolutionCount() const
+		{
+			return this->solutionCount;
+		}
+		
+		const ::std::vector<::rl::math::Vector>&
+		ParallelInverseKinematics::getSolutions() const
+		{
+			return this->solutions;
+		}
+		
+		void
+		ParallelInverseKinematics::reset()
+		{
+			this->solvers.clear();
+			this->kinematics.clear();
+		}
+		
+		void
+		ParallelInverseKinematics::seed(const ::std::mt19937::result_type& value)
+		{
+			this->randEngine.seed(value);
+		}
+		
+		void
+		ParallelInverseKinematics::setReference(const ::rl::math::Vector& reference)
+		{
+			this->reference = reference;
+		}
+		
+		void
+		ParallelInverseKinematics::setSolutionCount(const ::std::size_t& solutionCount)
+		{
+			this->solutionCount = ::std::max<::std::size_t>(solutionCount, 1);
+		}
+		
+		bool
+		ParallelInverseKinematics::solve()
+		{
+			::std::chrono::steady_clock::time_point start = ::std::chrono::steady_clock::now();
+			
+			if (nullptr == this->pool)
+			{
+				this->pool.reset(new ::rl::util::thread_pool(this->threads));
+			}
+			
+			while (this->kinematics.size() < this->pool->size())
+			{
+				this->kinematics.emplace_back(this->kinematic->clone());
+				this->solvers.emplace_back(this->function(this->kinematics.back().get()));
+			}
+			
+			::rl::math::Vector q0 = this->kinematic->getPosition();
+			::rl::math::Vector reference = this->reference.size() > 0 ? this->reference : q0;
+			
+			::std::vector<::std::mt19937::result_type> seeds(this->pool->size());
+			
+			for (::std::size_t i = 0; i < seeds.size(); ++i)
+			{
+				seeds[i] = this->randEngine();
+			}
+			
+			this->solutions.clear();
+			
+			::std::atomic<::std::size_t> attempts(0);
+			::std::mutex mutex;
+			::std::atomic<bool> stop(false);
+			
+			this->pool->run([&](const ::std::size_t& worker) {
+				Kinematic* kinematic = this->kinematics[worker].get();
+				InverseKinematics* solver = this->solvers[worker].get();
+				IterativeInverseKinematics* iterative = dynamic_cast<IterativeInverseKinematics*>(solver);
+				
+				solver->clearGoals();
+				
+				for (::std::size_t i = 0; i < this->goals.size(); ++i)
+				{
+					solver->addGoal(this->goals[i]);
+				}
+				
+				::std::chrono::nanoseconds duration = nullptr != iterative ? iterative->getDuration() : ::std::chrono::nanoseconds::zero();
+				
+				if (nullptr != iterative)
+				{
+					iterative->setEpsilon(this->getEpsilon());
+				}
+				
+				::std::uniform_real_distribution<::rl::math::Real> randDistribution(this->randDistribution.param());
+				::std::mt19937 randEngine(seeds[worker]);
+				::rl::math::Vector rand(kinematic->getDof());
+				::rl::math::Vector q(kinematic->getDofPosition());
+				
+				for (::std::size_t attempt = 0; !stop && attempts++ < this->getIterations(); ++attempt)
+				{
+					::std::chrono::nanoseconds remaining = this->getDuration() - (::std::chrono::steady_clock::now() - start);
+					
+					if (remaining <= ::std::chrono::nanoseconds::zero())
+					{
+						break;
+					}
+					
+					if (0 == worker && 0 == attempt)
+					{
+						q = q0;
+					}
+					else
+					{
+						for (::std::size_t i = 0; i < kinematic->getDof(); ++i)
+						{
+							rand(i) = randDistribution(randEngine);
+						}
+						
+						q = kinematic->generatePositionUniform(rand);
+					}
+					
+					kinematic->setPosition(q);
+					
+					if (nullptr != iterative)
+					{
+						iterative->setDuration(::std::min(duration, remaining));
+					}
+					
+					if (solver->solve())
+					{
+						kinematic->getPosition(q);
+						
+						::std::lock_guard<::std::mutex> lock(mutex);
+						
+						bool distinct = true;
+						
+						// solutions closer than this are considered identical
+						for (::std::size_t i = 0; i < this->solutions.size() && distinct; ++i)
+						{
+							distinct = this->kinematic->distance(q, this->solutions[i]) > static_cast<::rl::math::Real>(1.0e-3);
+						}
+						
+						if (distinct && this->solutions.size() < this->solutionCount)
+						{
+							this->solutions.push_back(q);
+						}
+						
+						if (this->solutions.size() >= this->solutionCount)
+						{
+							stop = true;
+						}
+					}
+					
+					// solvers without restarts return the same result every time
+					if (nullptr == iterative)
+					{
+						break;
+					}
+				}
+				
+				if (nullptr != iterative)
+				{
+					iterative->setDuration(duration);
+				}
+			});
+			
+			::std::sort(
+				this->solutions.begin(),
+				this->solutions.end(),
+				[&](const ::rl::math::Vector& a, const ::rl::math::Vector& b) {
+					return this->kinematic->transformedDistance(reference, a) < this->kinematic->transformedDistance(reference, b);
+				}
+			);
+			
+			this->kinematic->setPosition(this->solutions.empty() ? q0 : this->solutions.front());
+			
+			return !this->solutions.empty();
+		}
+	}
+}
@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_MDL_PARALLELINVERSEKINEMATICS_H
+#define RL_MDL_PARALLELINVERSEKINEMATICS_H
+
+#include <functional>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include <rl/math/Vector.h>
+#include <rl/util/thread_pool.h>
+
+#include "IterativeInverseKinematics.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		/**
+		 * Multi-start inverse kinematics running any solver on several threads.
+		 *
+		 * Every worker owns a clone of the kinematic model and a solver created
+		 * for it. Workers repeatedly call the solver from random configurations
+		 * until enough distinct solutions are found or the duration or number of
+		 * attempts is exhausted. The first attempt of the first worker starts
+		 * from the current configuration. Iterative solvers should be configured
+		 * with a small budget per attempt, as their duration is only limited to
+		 * the remaining time and running attempts are not interrupted.
+		 *
+		 * Found solutions are sorted by distance to a reference configuration,
+		 * the best one is set as position of the kinematic model.
+		 *
+		 * Clones are created on the first call to solve(), call reset() after
+		 * modifying the kinematic model.
+		 */
+		class RL_MDL_EXPORT ParallelInverseKinematics : public IterativeInverseKinematics
+		{
+		public:
+			/**
+			 * Create a solver for the given clone of the kinematic model.
+			 */
+			typedef ::std::function<InverseKinematics*(Kinematic*)> SolverFunction;
+			
+			ParallelInverseKinematics(Kinematic* kinematic, const SolverFunction& function, const ::std::size_t& threads = ::std::thread::hardware_concurrency());
+			
+			virtual ~ParallelInverseKinematics();
+			
+			const ::rl::math::Vector& getReference() const;
+			
+			const ::std::size_t& getSolutionCount() const;
+			
+			/**
+			 * Distinct solutions of the last call to solve(), sorted by distance
+			 * to the reference configuration.
+			 */
+			const ::std::vector<::rl::math::Vector>& getSolutions() const;
+			
+			void reset();
+			
+			void seed(const ::std::mt19937::result_type& value);
+			
+			/**
+			 * Set reference configuration for ranking solutions.
+			 *
+			 * An empty vector selects the current configuration at the start of
+			 * solve().
+			 */
+			void setReference(const ::rl::math::Vector& reference);
+			
+			/**
+			 * Set number of distinct solutions to find before cancelling the
+			 * remaining workers, one returns the first valid solution.
+			 */
+			void setSolutionCount(const ::std::size_t& solutionCount);
+			
+			bool solve();
+			
+		protected:
+			
+		private:
+			SolverFunction function;
+			
+			::std::vector<::std::unique_ptr<Kinematic>> kinematics;
+			
+			::std::unique_ptr<::rl::util::thread_pool> pool;
+			
+			::std::uniform_real_distribution<::rl::math::Real> randDistribution;
+			
+			::std::mt19937 randEngine;
+			
+			::rl::math::Vector reference;
+			
+			::std::size_t solutionCount;
+			
+			::std::vector<::rl::math::Vector> solutions;
+			
+			::std::vector<::std::unique_ptr<InverseKinematics>> solvers;
+			
+			::std::size_t threads;
+		};
+	}
+}
+
+#endif // RL_MDL_PARALLELINVERSEKINEMATICS_H
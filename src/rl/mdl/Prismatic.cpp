@@ -45,6 +45,24 @@ namespace rl
 		{
 		}
 		
+		void
+		Prismatic::calculateBatch(const ::rl::math::ConstMatrixRef& q, Batch& x) const
+		{
+			x.resize(12, q.cols());
+			Joint::setBatchLinear(this->x.linear(), x);
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				x.row(9 + i) = this->S(3 + i, 0) * (q.row(0).array() + this->offset(0));
+			}
+		}
+		
+		Prismatic*
+		Prismatic::clone() const
+		{
+			return new Prismatic(*this);
+		}
+		
 		void
 		Prismatic::setPosition(const ::rl::math::ConstVectorRef& q)
 		{
@@ -40,6 +40,10 @@ namespace rl
 			
 			virtual ~Prismatic();
 			
+			void calculateBatch(const ::rl::math::ConstMatrixRef& q, Batch& x) const;
+			
+			Prismatic* clone() const;
+			
 			void setPosition(const ::rl::math::ConstVectorRef& q);
 			
 		protected:
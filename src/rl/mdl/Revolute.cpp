@@ -48,6 +48,20 @@ namespace rl
 		{
 		}
 		
+		void
+		Revolute::calculateBatch(const ::rl::math::ConstMatrixRef& q, Batch& x) const
+		{
+			x.resize(12, q.cols());
+			Joint::setBatchRotation(this->S.block<3, 1>(0, 0), q.row(0).array() + this->offset(0), x);
+			Joint::setBatchTranslation(this->x.translation(), x);
+		}
+		
+		Revolute*
+		Revolute::clone() const
+		{
+			return new Revolute(*this);
+		}
+		
 		::rl::math::Real
 		Revolute::distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const
 		{
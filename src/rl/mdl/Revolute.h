@@ -40,6 +40,10 @@ namespace rl
 			
 			virtual ~Revolute();
 			
+			void calculateBatch(const ::rl::math::ConstMatrixRef& q, Batch& x) const;
+			
+			Revolute* clone() const;
+			
 			::rl::math::Real distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const;
 			
 			void interpolate(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2, const ::rl::math::Real& alpha, ::rl::math::VectorRef q) const;
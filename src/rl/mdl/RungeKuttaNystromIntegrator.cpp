@@ -32,7 +32,16 @@ namespace rl
 	namespace mdl
 	{
 		RungeKuttaNystromIntegrator::RungeKuttaNystromIntegrator(Dynamic* dynamic) :
-			Integrator(dynamic)
+			Integrator(dynamic),
+			dy(),
+			dy0(),
+			f(),
+			k1(),
+			k2(),
+			k3(),
+			k4(),
+			y(),
+			y0()
 		{
 		}
 		
@@ -43,57 +52,60 @@ namespace rl
 		void
 		RungeKuttaNystromIntegrator::integrate(const ::rl::math::Real& dt)
 		{
-			::rl::math::Vector y0 = this->dynamic->getPosition();
-			::rl::math::Vector dy0 = this->dynamic->getVelocity();
+			this->dynamic->getPosition(this->y0);
+			this->dynamic->getVelocity(this->dy0);
 			
 			this->dynamic->forwardDynamics();
 			
-			::rl::math::Vector f = this->dynamic->getAcceleration();
+			this->dynamic->getAcceleration(this->f);
 			
 			// k1 = dt / 2 * f
-			::rl::math::Vector k1 = dt / 2 * f;
+			this->k1 = dt / 2 * this->f;
 			
 			// y_0 + dt / 2 * dy_0 + dt / 4 * k_1
-			::rl::math::Vector y = y0 + dt / 2 * dy0 + dt / 4 * k1;
+			this->y = this->y0 + dt / 2 * this->dy0 + dt / 4 * this->k1;
 			// dy_0 + k1
-			::rl::math::Vector dy = dy0 + k1;
+			this->dy = this->dy0 + this->k1;
 			
-			this->dynamic->setPosition(y);
-			this->dynamic->setVelocity(dy);
+			this->dynamic->setPosition(this->y);
+			this->dynamic->setVelocity(this->dy);
 			this->dynamic->forwardDynamics();
 			
 			// k2 = dt / 2 * f
-			::rl::math::Vector k2 = dt / 2 * this->dynamic->getAcceleration();
+			this->dynamic->getAcceleration(this->k2);
+			this->k2 *= dt / 2;
 			
 			// dy_0 + k_2
-			dy = dy0 + k2;
+			this->dy = this->dy0 + this->k2;
 			
-			this->dynamic->setVelocity(dy);
+			this->dynamic->setVelocity(this->dy);
 			this->dynamic->forwardDynamics();
 			
 			// k3 = dt / 2 * f
-			::rl::math::Vector k3 = dt / 2 * this->dynamic->getAcceleration();
+			this->dynamic->getAcceleration(this->k3);
+			this->k3 *= dt / 2;
 			
 			// y_0 + dt * dy_0 + dt * k_3
-			y = y0 + dt * dy0 + dt * k3;
+			this->y = this->y0 + dt * this->dy0 + dt * this->k3;
 			// dy_0 + 2 * k_3
-			dy = dy0 + 2 * k3;
+			this->dy = this->dy0 + 2 * this->k3;
 			
-			this->dynamic->setPosition(y);
-			this->dynamic->setVelocity(dy);
+			this->dynamic->setPosition(this->y);
+			this->dynamic->setVelocity(this->dy);
 			this->dynamic->forwardDynamics();
 			
 			// k4 = dt / 2 * f
-			::rl::math::Vector k4 = dt / 2 * this->dynamic->getAcceleration();
+			this->dynamic->getAcceleration(this->k4);
+			this->k4 *= dt / 2;
 			
 			// y_0 + dy_0 * dt + dt / 3 * (k_1 + k_2 + k_3)
-			y = y0 + dy0 * dt + dt / 3 * (k1 + k2 + k3);
+			this->y = this->y0 + this->dy0 * dt + dt / 3 * (this->k1 + this->k2 + this->k3);
 			// dy_0 + 1 / 3 * (k_1 + 2 * k_2 + 2 * k_3 + k_4)
-			dy = dy0 + static_cast<::rl::math::Real>(1) / static_cast<::rl::math::Real>(3) * (k1 + 2 * k2 + 2 * k3 + k4);
+			this->dy = this->dy0 + static_cast<::rl::math::Real>(1) / static_cast<::rl::math::Real>(3) * (this->k1 + 2 * this->k2 + 2 * this->k3 + this->k4);
 			
-			this->dynamic->setPosition(y);
-			this->dynamic->setVelocity(dy);
-			this->dynamic->setAcceleration(f);
+			this->dynamic->setPosition(this->y);
+			this->dynamic->setVelocity(this->dy);
+			this->dynamic->setAcceleration(this->f);
 		}
 	}
 }
@@ -27,6 +27,8 @@
 #ifndef RL_MDL_RUNGEKUTTANYSTROMINTEGRATOR_H
 #define RL_MDL_RUNGEKUTTANYSTROMINTEGRATOR_H
 
+#include <rl/math/Vector.h>
+
 #include "Integrator.h"
 
 namespace rl
@@ -66,7 +68,23 @@ namespace rl
 		protected:
 			
 		private:
+			::rl::math::Vector dy;
+			
+			::rl::math::Vector dy0;
+			
+			::rl::math::Vector f;
+			
+			::rl::math::Vector k1;
+			
+			::rl::math::Vector k2;
+			
+			::rl::math::Vector k3;
+			
+			::rl::math::Vector k4;
+			
+			::rl::math::Vector y;
 			
+			::rl::math::Vector y0;
 		};
 	}
 }
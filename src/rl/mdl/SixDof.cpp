@@ -79,6 +79,24 @@ namespace rl
 		{
 		}
 		
+		void
+		SixDof::calculateBatch(const ::rl::math::ConstMatrixRef& q, Batch& x) const
+		{
+			x.resize(12, q.cols());
+			Joint::setBatchQuaternion(q.bottomRows(4), x);
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				x.row(9 + i) = q.row(i).array() + this->offset(i);
+			}
+		}
+		
+		SixDof*
+		SixDof::clone() const
+		{
+			return new SixDof(*this);
+		}
+		
 		void
 		SixDof::clamp(::rl::math::VectorRef q) const
 		{
@@ -62,6 +62,20 @@ namespace rl
 		{
 		}
 		
+		void
+		Spherical::calculateBatch(const ::rl::math::ConstMatrixRef& q, Batch& x) const
+		{
+			x.resize(12, q.cols());
+			Joint::setBatchQuaternion(q, x);
+			Joint::setBatchTranslation(this->x.translation(), x);
+		}
+		
+		Spherical*
+		Spherical::clone() const
+		{
+			return new Spherical(*this);
+		}
+		
 		void
 		Spherical::clamp(::rl::math::VectorRef q) const
 		{
@@ -40,6 +40,10 @@ namespace rl
 			
 			virtual ~Spherical();
 			
+			void calculateBatch(const ::rl::math::ConstMatrixRef& q, Batch& x) const;
+			
+			Spherical* clone() const;
+			
 			void clamp(::rl::math::VectorRef q) const;
 			
 			::rl::math::Real distance(const ::rl::math::ConstVectorRef& q1, const ::rl::math::ConstVectorRef& q2) const;
@@ -0,0 +1,152 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cmath>
+#include <rl/math/Rotation.h>
+
+#include "Exception.h"
+#include "Kinematic.h"
+#include "SphericalWristInverseKinematics.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		SphericalWristInverseKinematics::SphericalWristInverseKinematics(Kinematic* kinematic) :
+			AnalyticalInverseKinematics(kinematic),
+			center(::rl::math::Vector3::Zero())
+		{
+			this->update();
+		}
+		
+		SphericalWristInverseKinematics::~SphericalWristInverseKinematics()
+		{
+		}
+		
+		bool
+		SphericalWristInverseKinematics::solve()
+		{
+			this->solutions.clear();
+			
+			if (1 != this->goals.size() || 0 != this->goals.front().second)
+			{
+				throw Exception("rl::mdl::SphericalWristInverseKinematics::solve() - Only one goal for operational frame 0 supported");
+			}
+			
+			const ::rl::math::Transform& goal = this->goals.front().first;
+			::rl::math::Vector reference = this->kinematic->getPosition();
+			::rl::math::Vector q(6);
+			
+			// product of all joint motions
+			::rl::math::Transform g = goal * this->zero.inverse();
+			::rl::math::Vector3 c = g * this->center;
+			
+			// shoulder: wrist center keeps its offset along the rotated axis 2
+			::rl::math::Vector3 r = c - this->points[0];
+			::rl::math::Real q0[2];
+			::std::size_t n0 = calculateAngles(
+				r.dot(this->directions[1]),
+				r.dot(this->directions[0].cross(this->directions[1])),
+				(this->center - this->points[0]).dot(this->directions[1]),
+				q0
+			);
+			
+			// wrist center on axis 1
+			if (0 == n0 && r.cross(this->directions[0]).norm() < static_cast<::rl::math::Real>(1.0e-9))
+			{
+				q0[0] = reference(0);
+				n0 = 1;
+			}
+			
+			for (::std::size_t i = 0; i < n0; ++i)
+			{
+				::rl::math::Transform g0 = this->calculateRotation(0, q0[i]);
+				
+				// elbow: planar problem of axes 2 and 3
+				::rl::math::Real q12[2][2];
+				::std::size_t n12 = this->calculatePlanar(1, this->center, g0.inverse() * c, q12);
+				
+				for (::std::size_t j = 0; j < n12; ++j)
+				{
+					::rl::math::Transform g2 = g0 * this->calculateRotation(1, q12[j][0]) * this->calculateRotation(2, q12[j][1]);
+					
+					// wrist: remaining rotation about axes 4, 5, and 6
+					::rl::math::Matrix33 m = (g2.inverse() * g).linear();
+					const ::rl::math::Vector3& w3 = this->directions[3];
+					const ::rl::math::Vector3& w4 = this->directions[4];
+					const ::rl::math::Vector3& w5 = this->directions[5];
+					::rl::math::Real k = w4.dot(w5) * w3.dot(w4);
+					::rl::math::Real q4[2];
+					::std::size_t n4 = calculateAngles(w3.dot(w5) - k, w3.dot(w4.cross(w5)), w3.dot(m * w5) - k, q4);
+					
+					for (::std::size_t l = 0; l < n4; ++l)
+					{
+						::rl::math::Matrix33 r4 = ::rl::math::AngleAxis(q4[l], w4).toRotationMatrix();
+						::rl::math::Real q3 = calculateAngle(w3, r4 * w5, m * w5);
+						::rl::math::Matrix33 r3 = ::rl::math::AngleAxis(q3, w3).toRotationMatrix();
+						::rl::math::Vector3 x = w5.unitOrthogonal();
+						::rl::math::Real q5 = calculateAngle(w5, x, (r3 * r4).transpose() * m * x);
+						
+						q << q0[i], q12[j][0], q12[j][1], q3, q4[l], q5;
+						this->addSolution(q, reference, goal);
+					}
+				}
+			}
+			
+			return this->finish(reference);
+		}
+		
+		void
+		SphericalWristInverseKinematics::update()
+		{
+			this->updateAxes();
+			
+			if (6 != this->directions.size())
+			{
+				throw Exception("rl::mdl::SphericalWristInverseKinematics::update() - Model with other than six joints");
+			}
+			
+			::rl::math::Real epsilon = static_cast<::rl::math::Real>(1.0e-6);
+			
+			if (::std::abs(this->directions[0].dot(this->directions[1])) > epsilon || this->directions[1].cross(this->directions[2]).norm() > epsilon)
+			{
+				throw Exception("rl::mdl::SphericalWristInverseKinematics::update() - Axis 1 not perpendicular to parallel axes 2 and 3");
+			}
+			
+			if (this->directions[3].cross(this->directions[4]).norm() < epsilon || this->directions[4].cross(this->directions[5]).norm() < epsilon)
+			{
+				throw Exception("rl::mdl::SphericalWristInverseKinematics::update() - Parallel wrist axes");
+			}
+			
+			this->center = this->calculateIntersection(3, 4);
+			
+			if (this->distance(3, this->center) > epsilon || this->distance(4, this->center) > epsilon || this->distance(5, this->center) > epsilon)
+			{
+				throw Exception("rl::mdl::SphericalWristInverseKinematics::update() - Wrist axes do not intersect");
+			}
+		}
+	}
+}
@@ -44,6 +44,12 @@ namespace rl
 		{
 		}
 		
+		Transform*
+		Transform::clone() const
+		{
+			return new Transform(*this);
+		}
+		
 		void
 		Transform::forwardAcceleration()
 		{
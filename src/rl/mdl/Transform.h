@@ -57,6 +57,8 @@ namespace rl
 			
 			virtual ~Transform();
 			
+			virtual Transform* clone() const;
+			
 			virtual void forwardAcceleration();
 			
 			virtual void forwardDynamics1();
@@ -40,6 +40,12 @@ namespace rl
 		{
 		}
 		
+		World*
+		World::clone() const
+		{
+			return new World(*this);
+		}
+		
 		void
 		World::forwardAcceleration()
 		{
@@ -40,6 +40,8 @@ namespace rl
 			
 			virtual ~World();
 			
+			World* clone() const;
+			
 			void forwardAcceleration();
 			
 			void forwardDynamics1();
@@ -47,7 +47,7 @@ namespace rl
 		Rrt::Vertex
 		AddRrtConCon::addVertex(Tree& tree, const VectorPtr& q)
 		{
-			::std::shared_ptr<VertexBundle> bundle = ::std::make_shared<VertexBundle>();
+			::std::shared_ptr<VertexBundle> bundle = this->arena.makeShared<VertexBundle>();
 			bundle->index = ::boost::num_vertices(tree) - 1;
 			bundle->q = q;
 			bundle->radius = ::std::numeric_limits<::rl::math::Real>::max();
@@ -82,15 +82,15 @@ namespace rl
 		{
 			this->time = ::std::chrono::steady_clock::now();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->start));
-			this->begin[1] = this->addVertex(this->tree[1], ::std::make_shared<::rl::math::Vector>(*this->goal));
+			this->begin[0] = this->addVertex(this->tree[0], this->arena.makeShared<::rl::math::Vector>(*this->start));
+			this->begin[1] = this->addVertex(this->tree[1], this->arena.makeShared<::rl::math::Vector>(*this->goal));
 			
 			Tree* a = &this->tree[0];
 			Tree* b = &this->tree[1];
 			
 			::rl::math::Vector chosen(this->model->getDofPosition());
 			
-			while ((::std::chrono::steady_clock::now() - this->time) < this->duration)
+			while (!this->isExpired())
 			{
 				for (::std::size_t j = 0; j < 2; ++j)
 				{
@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <new>
+
+#include "Arena.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		Arena::Arena(const ::std::size_t& size) :
+			chunks(),
+			free(0),
+			next(nullptr),
+			size(size)
+		{
+		}
+		
+		Arena::~Arena()
+		{
+		}
+		
+		void*
+		Arena::allocate(const ::std::size_t& size, const ::std::size_t& alignment)
+		{
+			if (nullptr == ::std::align(alignment, size, this->next, this->free))
+			{
+				::std::size_t capacity = ::std::max(this->size, size + alignment);
+				this->chunks.emplace_back(new unsigned char[capacity]);
+				this->next = this->chunks.back().get();
+				this->free = capacity;
+				
+				if (nullptr == ::std::align(alignment, size, this->next, this->free))
+				{
+					throw ::std::bad_alloc();
+				}
+			}
+			
+			void* p = this->next;
+			this->next = static_cast<unsigned char*>(this->next) + size;
+			this->free -= size;
+			return p;
+		}
+		
+		void
+		Arena::clear()
+		{
+			this->chunks.clear();
+			this->free = 0;
+			this->next = nullptr;
+		}
+	}
+}
@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef RL_PLAN_ARENA_H
+#define RL_PLAN_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <rl/plan/export.h>
+
+namespace rl
+{
+	namespace plan
+	{
+		/**
+		 * Memory arena for objects allocated per vertex.
+		 *
+		 * Memory is handed out from large chunks and only released as a whole by
+		 * clear(), allocated objects keep their address. Objects have to be
+		 * destroyed before clear().
+		 */
+		class RL_PLAN_EXPORT Arena
+		{
+		public:
+			Arena(const ::std::size_t& size = 65536);
+			
+			virtual ~Arena();
+			
+			void* allocate(const ::std::size_t& size, const ::std::size_t& alignment);
+			
+			void clear();
+			
+			/**
+			 * Create an object in the arena, shared like ::std::make_shared().
+			 */
+			template<typename T, typename... Args>
+			::std::shared_ptr<T> makeShared(Args&&... args);
+			
+		protected:
+			
+		private:
+			::std::vector<::std::unique_ptr<unsigned char[]>> chunks;
+			
+			/** Free bytes in last chunk. */
+			::std::size_t free;
+			
+			/** Next free byte in last chunk. */
+			void* next;
+			
+			/** Chunk size in bytes. */
+			::std::size_t size;
+		};
+		
+		/**
+		 * Allocator using an Arena, e.g., for ::std::allocate_shared().
+		 *
+		 * Deallocation is a no-op, memory is reclaimed by Arena::clear().
+		 */
+		template<typename T>
+		class ArenaAllocator
+		{
+		public:
+			typedef T value_type;
+			
+			ArenaAllocator(Arena* arena) :
+				arena(arena)
+			{
+			}
+			
+			template<typename U>
+			ArenaAllocator(const ArenaAllocator<U>& other) :
+				arena(other.arena)
+			{
+			}
+			
+			T* allocate(const ::std::size_t& n)
+			{
+				return static_cast<T*>(this->arena->allocate(n * sizeof(T), alignof(T)));
+			}
+			
+			void deallocate(T* /*p*/, const ::std::size_t& /*n*/)
+			{
+			}
+			
+			Arena* arena;
+			
+		protected:
+			
+		private:
+			
+		};
+		
+		template<typename T, typename... Args>
+		::std::shared_ptr<T>
+		Arena::makeShared(Args&&... args)
+		{
+			return ::std::allocate_shared<T>(ArenaAllocator<T>(this), ::std::forward<Args>(args)...);
+		}
+		
+		template<typename T, typename U>
+		bool
+		operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+		{
+			return lhs.arena == rhs.arena;
+		}
+		
+		template<typename T, typename U>
+		bool
+		operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+		{
+			return lhs.arena != rhs.arena;
+		}
+	}
+}
+
+#endif // RL_PLAN_ARENA_H
@@ -0,0 +1,249 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <limits>
+#include <queue>
+#include <typeinfo>
+#include <rl/mdl/Prismatic.h>
+#include <rl/mdl/Revolute.h>
+#include <rl/sg/Body.h>
+#include <rl/sg/DistanceScene.h>
+
+#include "ClearanceVerifier.h"
+#include "DistanceModel.h"
+#include "Exception.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		ClearanceVerifier::ClearanceVerifier() :
+			Verifier(),
+			radii()
+		{
+		}
+		
+		ClearanceVerifier::~ClearanceVerifier()
+		{
+		}
+		
+		::rl::math::Vector
+		ClearanceVerifier::calculateRadii() const
+		{
+			::rl::mdl::Kinematic* mdl = this->model->mdl;
+			
+			if (nullptr == mdl)
+			{
+				throw Exception("rl::plan::ClearanceVerifier::calculateRadii() - Model requires rl::mdl::Kinematic");
+			}
+			
+			// largest distance of a body point to its body frame
+			
+			::rl::math::Real extent = 0;
+			::std::vector<::rl::math::Vector3> points;
+			
+			for (::std::size_t i = 0; i < this->model->getBodies(); ++i)
+			{
+				::rl::sg::Body* body = this->model->getBody(i);
+				
+				if (!body->points.empty())
+				{
+					points = body->points;
+				}
+				else if (!(body->max - body->min).isZero())
+				{
+					body->getBoundingBoxPoints(::rl::math::Transform::Identity(), points);
+				}
+				else if (body->begin() != body->end())
+				{
+					throw Exception("rl::plan::ClearanceVerifier::calculateRadii() - Bodies require points or bounding box");
+				}
+				else
+				{
+					points.clear();
+				}
+				
+				for (::std::size_t j = 0; j < points.size(); ++j)
+				{
+					extent = ::std::max(extent, points[j].norm());
+				}
+			}
+			
+			// largest translation of each transform and of all transforms following it
+			
+			::std::vector<::rl::math::Real> reach(mdl->getTransforms() + 1, extent);
+			
+			for (::std::size_t i = mdl->getTransforms(); i > 0; --i)
+			{
+				::rl::mdl::Transform* transform = mdl->getTransform(i - 1);
+				
+				if (typeid(*transform) == typeid(::rl::mdl::Prismatic))
+				{
+					::rl::mdl::Joint* joint = static_cast<::rl::mdl::Joint*>(transform);
+					reach[i - 1] = reach[i] + ::std::max(::std::abs(joint->min(0) + joint->offset(0)), ::std::abs(joint->max(0) + joint->offset(0)));
+				}
+				else if (typeid(*transform) == typeid(::rl::mdl::Revolute) || nullptr == dynamic_cast<::rl::mdl::Joint*>(transform))
+				{
+					reach[i - 1] = reach[i] + transform->x.translation().norm();
+				}
+				else
+				{
+					throw Exception("rl::plan::ClearanceVerifier::calculateRadii() - Only revolute and prismatic joints supported");
+				}
+			}
+			
+			// transforms are ordered depth first, so the distal chain of a joint follows it
+			
+			::rl::math::Vector radii(mdl->getDofPosition());
+			
+			for (::std::size_t i = 0, j = 0; i < mdl->getTransforms(); ++i)
+			{
+				::rl::mdl::Transform* transform = mdl->getTransform(i);
+				
+				if (typeid(*transform) == typeid(::rl::mdl::Prismatic))
+				{
+					radii(j++) = 1;
+				}
+				else if (typeid(*transform) == typeid(::rl::mdl::Revolute))
+				{
+					radii(j++) = reach[i];
+				}
+			}
+			
+			return radii;
+		}
+		
+		::rl::math::Real
+		ClearanceVerifier::clearance(DistanceModel* model, const ::rl::math::Vector& q) const
+		{
+			model->setPosition(q);
+			model->updateFrames();
+			
+			::rl::math::Real clearance = ::std::numeric_limits<::rl::math::Real>::max();
+			::rl::math::Vector3 point1;
+			::rl::math::Vector3 point2;
+			
+			for (::std::size_t i = 0; i < model->getBodies(); ++i)
+			{
+				clearance = ::std::min(clearance, model->distance(i, point1, point2));
+			}
+			
+			return clearance;
+		}
+		
+		bool
+		ClearanceVerifier::isColliding(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d)
+		{
+			assert(u.size() == this->model->getDofPosition());
+			assert(v.size() == this->model->getDofPosition());
+			
+			DistanceModel* model = dynamic_cast<DistanceModel*>(this->model);
+			
+			if (nullptr == model)
+			{
+				throw Exception("rl::plan::ClearanceVerifier::isColliding() - Model requires rl::plan::DistanceModel");
+			}
+			
+			if (nullptr == dynamic_cast<::rl::sg::DistanceScene*>(model->scene))
+			{
+				throw Exception("rl::plan::ClearanceVerifier::isColliding() - Scene requires rl::sg::DistanceScene");
+			}
+			
+			if (0 == this->radii.size())
+			{
+				this->radii = this->calculateRadii();
+			}
+			
+			assert(this->radii.size() == u.size());
+			
+			// bodies of a self-colliding pair may approach each other from both sides
+			
+			::rl::math::Real factor = 1;
+			
+			for (::std::size_t i = 0; i < model->getBodies(); ++i)
+			{
+				for (::std::size_t j = 0; j < i; ++j)
+				{
+					if (model->areColliding(i, j))
+					{
+						factor = 2;
+					}
+				}
+			}
+			
+			::rl::math::Real displacement = factor * (v - u).cwiseAbs().dot(this->radii);
+			
+			Interval interval;
+			interval.begin = 0;
+			interval.clearance1 = this->clearance(model, u);
+			interval.clearance2 = this->clearance(model, v);
+			interval.end = 1;
+			
+			if (interval.clearance1 <= 0 || interval.clearance2 <= 0)
+			{
+				return true;
+			}
+			
+			::std::queue<Interval> queue;
+			queue.push(interval);
+			
+			::rl::math::Vector inter(u.size());
+			
+			while (!queue.empty())
+			{
+				interval = queue.front();
+				queue.pop();
+				
+				if ((interval.end - interval.begin) * displacement < interval.clearance1 + interval.clearance2)
+				{
+					continue;
+				}
+				
+				if ((interval.end - interval.begin) * d <= this->delta)
+				{
+					return true;
+				}
+				
+				::rl::math::Real midpoint = (interval.begin + interval.end) / 2;
+				
+				this->model->interpolate(u, v, midpoint, inter);
+				::rl::math::Real clearance = this->clearance(model, inter);
+				
+				if (clearance <= 0)
+				{
+					return true;
+				}
+				
+				Interval first = {interval.begin, interval.clearance1, clearance, midpoint};
+				queue.push(first);
+				Interval second = {midpoint, clearance, interval.clearance2, interval.end};
+				queue.push(second);
+			}
+			
+			return false;
+		}
+	}
+}
@@ -0,0 +1,94 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_CLEARANCEVERIFIER_H
+#define RL_PLAN_CLEARANCEVERIFIER_H
+
+#include "Verifier.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		class DistanceModel;
+		
+		/**
+		 * Edge verification by certified free intervals.
+		 *
+		 * Workspace clearance is calculated at the ends of an interval with
+		 * DistanceModel::distance(). As no robot point moves further than the
+		 * joint motion weighted by radii, the interval is free if this
+		 * displacement is smaller than the sum of both clearances. Otherwise it
+		 * is bisected, so distance queries concentrate where clearance is small.
+		 * Intervals that cannot be certified before reaching a length of delta
+		 * are reported as colliding.
+		 *
+		 * F. Schwarzer, M. Saha, and J.-C. Latombe. Adaptive dynamic collision
+		 * checking for single and multiple articulated robots in complex
+		 * environments. IEEE Transactions on Robotics, 21(3):338-353, 2005.
+		 */
+		class RL_PLAN_EXPORT ClearanceVerifier : public Verifier
+		{
+		public:
+			ClearanceVerifier();
+			
+			virtual ~ClearanceVerifier();
+			
+			using Verifier::isColliding;
+			
+			bool isColliding(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d);
+			
+			/**
+			 * Upper bound on the displacement of any robot point per unit motion of each joint.
+			 *
+			 * If empty, this is calculated on first use from the kinematic chain
+			 * and the points or bounding boxes of the bodies, which requires
+			 * revolute and prismatic joints only.
+			 */
+			::rl::math::Vector radii;
+			
+		protected:
+			
+		private:
+			struct Interval
+			{
+				::rl::math::Real begin;
+				
+				::rl::math::Real clearance1;
+				
+				::rl::math::Real clearance2;
+				
+				::rl::math::Real end;
+			};
+			
+			::rl::math::Vector calculateRadii() const;
+			
+			::rl::math::Real clearance(DistanceModel* model, const ::rl::math::Vector& q) const;
+		};
+	}
+}
+
+#endif // RL_PLAN_CLEARANCEVERIFIER_H
@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "CollisionCache.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		const ::std::size_t CollisionCache::SHARDS = 16;
+		
+		CollisionCache::CollisionCache(const ::std::size_t& capacity, const ::rl::math::Real& resolution) :
+			capacity(capacity),
+			fingerprint(::std::numeric_limits<::std::size_t>::max()),
+			hits(0),
+			misses(0),
+			mutex(),
+			resolution(resolution),
+			shards(new Shard[CollisionCache::SHARDS])
+		{
+		}
+		
+		CollisionCache::~CollisionCache()
+		{
+		}
+		
+		void
+		CollisionCache::clear()
+		{
+			for (::std::size_t i = 0; i < CollisionCache::SHARDS; ++i)
+			{
+				::std::lock_guard<::std::mutex> lock(this->shards[i].mutex);
+				this->shards[i].entries.clear();
+				this->shards[i].order.clear();
+			}
+		}
+		
+		bool
+		CollisionCache::equals(const ::std::vector<::std::int64_t>& key, const ::rl::math::Vector& q) const
+		{
+			if (key.size() != static_cast<::std::size_t>(q.size()))
+			{
+				return false;
+			}
+			
+			for (::std::ptrdiff_t i = 0; i < q.size(); ++i)
+			{
+				if (key[i] != this->quantize(q(i)))
+				{
+					return false;
+				}
+			}
+			
+			return true;
+		}
+		
+		bool
+		CollisionCache::find(const ::rl::math::Vector& q, ::std::size_t& body)
+		{
+			::std::size_t hash = this->hash(q);
+			Shard& shard = this->shards[hash % CollisionCache::SHARDS];
+			
+			::std::lock_guard<::std::mutex> lock(shard.mutex);
+			
+			::std::unordered_map<::std::size_t, Entry>::const_iterator found = shard.entries.find(hash);
+			
+			if (shard.entries.end() == found || !this->equals(found->second.key, q))
+			{
+				++this->misses;
+				return false;
+			}
+			
+			++this->hits;
+			body = found->second.body;
+			return true;
+		}
+		
+		::std::size_t
+		CollisionCache::getCapacity() const
+		{
+			return this->capacity;
+		}
+		
+		::std::size_t
+		CollisionCache::getHits() const
+		{
+			return this->hits;
+		}
+		
+		::std::size_t
+		CollisionCache::getMisses() const
+		{
+			return this->misses;
+		}
+		
+		::rl::math::Real
+		CollisionCache::getResolution() const
+		{
+			return this->resolution;
+		}
+		
+		::std::size_t
+		CollisionCache::hash(const ::rl::math::Vector& q) const
+		{
+			::std::size_t seed = q.size();
+			
+			for (::std::ptrdiff_t i = 0; i < q.size(); ++i)
+			{
+				seed ^= ::std::hash<::std::int64_t>()(this->quantize(q(i))) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			}
+			
+			return seed;
+		}
+		
+		void
+		CollisionCache::insert(const ::rl::math::Vector& q, const ::std::size_t& body)
+		{
+			::std::size_t hash = this->hash(q);
+			Shard& shard = this->shards[hash % CollisionCache::SHARDS];
+			
+			Entry entry;
+			entry.body = body;
+			entry.key.resize(q.size());
+			
+			for (::std::ptrdiff_t i = 0; i < q.size(); ++i)
+			{
+				entry.key[i] = this->quantize(q(i));
+			}
+			
+			::std::lock_guard<::std::mutex> lock(shard.mutex);
+			
+			::std::unordered_map<::std::size_t, Entry>::iterator found = shard.entries.find(hash);
+			
+			if (shard.entries.end() != found)
+			{
+				// replace entry with same hash but different configuration
+				found->second = ::std::move(entry);
+				return;
+			}
+			
+			shard.entries.emplace(hash, ::std::move(entry));
+			shard.order.push_back(hash);
+			
+			while (shard.order.size() > ::std::max<::std::size_t>(1, this->capacity / CollisionCache::SHARDS))
+			{
+				shard.entries.erase(shard.order.front());
+				shard.order.pop_front();
+			}
+		}
+		
+		::std::int64_t
+		CollisionCache::quantize(const ::rl::math::Real& q) const
+		{
+			return static_cast<::std::int64_t>(::std::floor(q / this->resolution + static_cast<::rl::math::Real>(0.5)));
+		}
+		
+		void
+		CollisionCache::resetCounters()
+		{
+			this->hits = 0;
+			this->misses = 0;
+		}
+		
+		void
+		CollisionCache::update(const ::std::size_t& fingerprint)
+		{
+			if (fingerprint == this->fingerprint)
+			{
+				return;
+			}
+			
+			::std::lock_guard<::std::mutex> lock(this->mutex);
+			
+			if (fingerprint != this->fingerprint)
+			{
+				this->clear();
+				this->fingerprint = fingerprint;
+			}
+		}
+	}
+}
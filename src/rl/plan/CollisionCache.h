@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_COLLISIONCACHE_H
+#define RL_PLAN_COLLISIONCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <rl/math/Vector.h>
+#include <rl/plan/export.h>
+
+namespace rl
+{
+	namespace plan
+	{
+		/**
+		 * Bounded cache of collision query results.
+		 *
+		 * Results are stored per cell of a grid with spacing resolution in
+		 * configuration space, so configurations in the same cell share a result.
+		 * The cache is split into shards with separate locks and may be used
+		 * concurrently. Each shard drops its oldest entries when full, entries
+		 * with colliding hashes replace each other.
+		 */
+		class RL_PLAN_EXPORT CollisionCache
+		{
+		public:
+			CollisionCache(const ::std::size_t& capacity = 1000000, const ::rl::math::Real& resolution = 1.0e-6);
+			
+			virtual ~CollisionCache();
+			
+			void clear();
+			
+			/**
+			 * Look up the result of a configuration.
+			 *
+			 * @param[out] body Colliding body, number of bodies if free
+			 * @return True if a result was found
+			 */
+			bool find(const ::rl::math::Vector& q, ::std::size_t& body);
+			
+			::std::size_t getCapacity() const;
+			
+			::std::size_t getHits() const;
+			
+			::std::size_t getMisses() const;
+			
+			::rl::math::Real getResolution() const;
+			
+			void insert(const ::rl::math::Vector& q, const ::std::size_t& body);
+			
+			void resetCounters();
+			
+			/**
+			 * Clear the cache if the fingerprint of scene and robot changed.
+			 *
+			 * Call this with a hash of everything the stored results depend on, see
+			 * SimpleModel::getFingerprint().
+			 */
+			void update(const ::std::size_t& fingerprint);
+			
+		protected:
+			
+		private:
+			struct Entry
+			{
+				::std::size_t body;
+				
+				::std::vector<::std::int64_t> key;
+			};
+			
+			struct Shard
+			{
+				::std::unordered_map<::std::size_t, Entry> entries;
+				
+				::std::mutex mutex;
+				
+				::std::deque<::std::size_t> order;
+			};
+			
+			bool equals(const ::std::vector<::std::int64_t>& key, const ::rl::math::Vector& q) const;
+			
+			::std::size_t hash(const ::rl::math::Vector& q) const;
+			
+			::std::int64_t quantize(const ::rl::math::Real& q) const;
+			
+			::std::size_t capacity;
+			
+			::std::atomic<::std::size_t> fingerprint;
+			
+			::std::atomic<::std::size_t> hits;
+			
+			::std::atomic<::std::size_t> misses;
+			
+			::std::mutex mutex;
+			
+			::rl::math::Real resolution;
+			
+			::std::unique_ptr<Shard[]> shards;
+			
+			static const ::std::size_t SHARDS;
+		};
+	}
+}
+
+#endif // RL_PLAN_COLLISIONCACHE_H
@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <rl/sg/Body.h>
+#include <rl/sg/SimpleScene.h>
+
+#include "CollisionContext.h"
+#include "Exception.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		::std::mutex CollisionContext::mutex;
+		
+		CollisionContext::CollisionContext(SimpleModel* model) :
+			SimpleModel(),
+			kinematic()
+		{
+			if (nullptr == model->mdl)
+			{
+				throw Exception("rl::plan::CollisionContext::CollisionContext() - Model requires rl::mdl::Kinematic");
+			}
+			
+			if (nullptr == dynamic_cast<::rl::sg::SimpleScene*>(model->scene))
+			{
+				throw Exception("rl::plan::CollisionContext::CollisionContext() - Scene requires rl::sg::SimpleScene");
+			}
+			
+			this->kinematic.reset(model->mdl->clone());
+			this->mdl = this->kinematic.get();
+			this->model = model->model;
+			this->scene = model->scene;
+			this->threads = 1;
+		}
+		
+		CollisionContext::~CollisionContext()
+		{
+		}
+		
+		bool
+		CollisionContext::isColliding()
+		{
+			++this->totalQueries;
+			
+			::rl::sg::SimpleScene* scene = dynamic_cast<::rl::sg::SimpleScene*>(this->scene);
+			
+			::std::unique_lock<::std::mutex> lock(CollisionContext::mutex, ::std::defer_lock);
+			
+			if (!scene->isReentrant())
+			{
+				lock.lock();
+			}
+			
+			::rl::math::Transform frame;
+			
+			for (::std::size_t i = 0; i < this->model->getNumBodies(); ++i)
+			{
+				if (this->isColliding(i))
+				{
+					for (::rl::sg::Scene::Iterator j = this->scene->begin(); j != this->scene->end(); ++j)
+					{
+						if (this->model != *j)
+						{
+							for (::rl::sg::Model::Iterator k = (*j)->begin(); k != (*j)->end(); ++k)
+							{
+								(*k)->getFrame(frame);
+								
+								if (scene->areColliding(this->model->getBody(i), this->mdl->getBodyFrame(i), *k, frame))
+								{
+									this->body = i;
+									return true;
+								}
+							}
+						}
+					}
+				}
+				
+				for (::std::size_t j = 0; j < i; ++j)
+				{
+					if (this->areColliding(i, j))
+					{
+						if (scene->areColliding(this->model->getBody(i), this->mdl->getBodyFrame(i), this->model->getBody(j), this->mdl->getBodyFrame(j)))
+						{
+							this->body = i;
+							return true;
+						}
+					}
+				}
+			}
+			
+			this->body = this->getBodies();
+			++this->freeQueries;
+			return false;
+		}
+		
+		bool
+		CollisionContext::isColliding(const ::rl::math::Vector& q)
+		{
+			this->setPosition(q);
+			this->updateFrames(false);
+			return this->isCollidingCached(q);
+		}
+		
+		void
+		CollisionContext::updateFrames(const bool& doUpdateModel)
+		{
+			this->mdl->forwardPosition();
+			
+			if (doUpdateModel)
+			{
+				::std::lock_guard<::std::mutex> lock(CollisionContext::mutex);
+				
+				for (::std::size_t i = 0; i < this->model->getNumBodies(); ++i)
+				{
+					this->model->getBody(i)->setFrame(this->mdl->getBodyFrame(i));
+				}
+			}
+		}
+	}
+}
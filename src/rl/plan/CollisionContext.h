@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_COLLISIONCONTEXT_H
+#define RL_PLAN_COLLISIONCONTEXT_H
+
+#include <memory>
+#include <mutex>
+#include <rl/mdl/Kinematic.h>
+
+#include "SimpleModel.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		/**
+		 * Collision checking context for concurrent queries.
+		 *
+		 * A context shares the scene and collision geometry of a SimpleModel, but
+		 * owns a copy of its kinematic model and does not modify the frames of the
+		 * shared scene during queries. Each thread may use its own context in parallel to the
+		 * others. Queries are lock-free if rl::sg::SimpleScene::isReentrant() is
+		 * true for the scene and serialized otherwise.
+		 */
+		class RL_PLAN_EXPORT CollisionContext : public SimpleModel
+		{
+		public:
+			CollisionContext(SimpleModel* model);
+			
+			virtual ~CollisionContext();
+			
+			using SimpleModel::isColliding;
+			
+			bool isColliding();
+			
+			/** Check configuration q without modifying the frames of the shared scene. */
+			bool isColliding(const ::rl::math::Vector& q);
+			
+			/**
+			 * Update the frames of the kinematic model.
+			 *
+			 * With doUpdateModel, the frames are also written to the bodies of the
+			 * shared scene, serialized with all other contexts.
+			 */
+			void updateFrames(const bool& doUpdateModel = true);
+			
+		protected:
+			
+		private:
+			::std::unique_ptr<::rl::mdl::Kinematic> kinematic;
+			
+			/**
+			 * Serializes writes to the frames of the shared scene, as well as
+			 * queries on scenes that are not reentrant.
+			 */
+			static ::std::mutex mutex;
+		};
+	}
+}
+
+#endif // RL_PLAN_COLLISIONCONTEXT_H
@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <rl/sg/Body.h>
+#include <rl/sg/SweepScene.h>
+
+#include "ContinuousVerifier.h"
+#include "Exception.h"
+#include "SimpleModel.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		ContinuousVerifier::ContinuousVerifier() :
+			Verifier()
+		{
+		}
+		
+		ContinuousVerifier::~ContinuousVerifier()
+		{
+		}
+		
+		bool
+		ContinuousVerifier::isColliding(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d)
+		{
+			assert(u.size() == this->model->getDofPosition());
+			assert(v.size() == this->model->getDofPosition());
+			
+			::rl::sg::SweepScene* scene = dynamic_cast<::rl::sg::SweepScene*>(this->model->scene);
+			
+			if (nullptr == scene)
+			{
+				throw Exception("rl::plan::ContinuousVerifier::isColliding() - Scene requires rl::sg::SweepScene");
+			}
+			
+			::std::size_t bodies = this->model->getBodies();
+			::std::size_t steps = ::std::max<::std::size_t>(1, this->getSteps(d));
+			
+			::std::vector<::rl::math::Transform> start(bodies);
+			::std::vector<::rl::math::Transform> goal(bodies);
+			
+			this->model->setPosition(u);
+			this->model->updateFrames(false);
+			
+			for (::std::size_t i = 0; i < bodies; ++i)
+			{
+				start[i] = this->model->getFrame(i);
+			}
+			
+			::rl::math::Vector inter(u.size());
+			::rl::math::Transform frame;
+			::rl::math::Real time;
+			
+			for (::std::size_t s = 1; s <= steps; ++s)
+			{
+				this->model->interpolate(u, v, static_cast<::rl::math::Real>(s) / static_cast<::rl::math::Real>(steps), inter);
+				this->model->setPosition(inter);
+				this->model->updateFrames(false);
+				
+				for (::std::size_t i = 0; i < bodies; ++i)
+				{
+					goal[i] = this->model->getFrame(i);
+				}
+				
+				for (::std::size_t i = 0; i < bodies; ++i)
+				{
+					if (this->model->isColliding(i))
+					{
+						for (::rl::sg::Scene::Iterator j = scene->begin(); j != scene->end(); ++j)
+						{
+							if (this->model->model != *j)
+							{
+								for (::rl::sg::Model::Iterator k = (*j)->begin(); k != (*j)->end(); ++k)
+								{
+									(*k)->getFrame(frame);
+									
+									if (scene->sweep(this->model->getBody(i), start[i], goal[i], *k, frame, frame, time))
+									{
+										return true;
+									}
+								}
+							}
+						}
+					}
+					
+					for (::std::size_t j = 0; j < i; ++j)
+					{
+						if (this->model->areColliding(i, j))
+						{
+							if (scene->sweep(this->model->getBody(i), start[i], goal[i], this->model->getBody(j), start[j], goal[j], time))
+							{
+								return true;
+							}
+						}
+					}
+				}
+				
+				::std::swap(start, goal);
+			}
+			
+			return false;
+		}
+	}
+}
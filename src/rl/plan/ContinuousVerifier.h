@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_CONTINUOUSVERIFIER_H
+#define RL_PLAN_CONTINUOUSVERIFIER_H
+
+#include "Verifier.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		/**
+		 * Continuous collision checking of edges.
+		 *
+		 * The edge is split into getSteps() segments and the motion of each body
+		 * between the frames at the ends of a segment is checked by
+		 * rl::sg::SweepScene::sweep(), instead of sampling isolated
+		 * configurations. Within a segment, body motion is approximated by the
+		 * interpolation of the collision backend, so delta only needs to be small
+		 * enough for this approximation to follow the joint space path and may be
+		 * chosen much larger than for discrete verifiers.
+		 */
+		class RL_PLAN_EXPORT ContinuousVerifier : public Verifier
+		{
+		public:
+			ContinuousVerifier();
+			
+			virtual ~ContinuousVerifier();
+			
+			using Verifier::isColliding;
+			
+			bool isColliding(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d);
+			
+		protected:
+			
+		private:
+			
+		};
+	}
+}
+
+#endif // RL_PLAN_CONTINUOUSVERIFIER_H
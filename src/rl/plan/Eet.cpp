@@ -93,7 +93,7 @@ namespace rl
 		Eet::Vertex
 		Eet::addVertex(Tree& tree, const VectorPtr& q)
 		{
-			::std::shared_ptr<VertexBundle> bundle = ::std::make_shared<VertexBundle>();
+			::std::shared_ptr<VertexBundle> bundle = this->arena.makeShared<VertexBundle>();
 			bundle->index = ::boost::num_vertices(tree) - 1;
 			bundle->q = q;
 			
@@ -120,8 +120,8 @@ namespace rl
 			do
 			{
 				VertexBundle best;
-				best.q = ::std::make_shared<::rl::math::Vector>(this->model->getDofPosition());
-				best.t = ::std::make_shared<::rl::math::Transform>();
+				best.q = this->arena.makeShared<::rl::math::Vector>(this->model->getDofPosition());
+				best.t = this->arena.makeShared<::rl::math::Transform>();
 				
 				state = this->expand(get(tree, n), *get(tree, nearest.second)->t, chosen, distance, best); // TODO
 				
@@ -236,8 +236,8 @@ namespace rl
 			Vertex extended = nullptr;
 			
 			VertexBundle best;
-			best.q = ::std::make_shared<::rl::math::Vector>(this->model->getDofPosition());
-			best.t = ::std::make_shared<::rl::math::Transform>();
+			best.q = this->arena.makeShared<::rl::math::Vector>(this->model->getDofPosition());
+			best.t = this->arena.makeShared<::rl::math::Transform>();
 			
 			if (this->expand(get(tree, nearest.second), *get(tree, nearest.second)->t, chosen, distance, best) >= 0)
 			{
@@ -391,10 +391,10 @@ namespace rl
 			
 			// tree initialization with start configuration
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->start));
+			this->begin[0] = this->addVertex(this->tree[0], this->arena.makeShared<::rl::math::Vector>(*this->start));
 			this->model->setPosition(*this->start);
 			this->model->updateFrames();
-			get(this->tree[0], this->begin[0])->t = ::std::make_shared<::rl::math::Transform>(this->model->forwardPosition());
+			get(this->tree[0], this->begin[0])->t = this->arena.makeShared<::rl::math::Transform>(this->model->forwardPosition());
 			this->nn.push(WorkspaceMetric::Value(get(this->tree[0], this->begin[0])->t.get(), begin[0]));
 			
 			::rl::math::Transform chosen;
@@ -407,7 +407,7 @@ namespace rl
 			WorkspaceSphereVector::iterator i = ++path.begin();
 			::rl::math::Real sigma = gamma; // initialize exploration/exploitation balance
 			
-			while ((::std::chrono::steady_clock::now() - this->time) < this->duration) // search until goal reached
+			while (!this->isExpired()) // search until goal reached
 			{
 				if (sigma < 1) // sample is within current sphere
 				{
@@ -52,6 +52,8 @@ namespace rl
 			
 			::rl::math::Vector generateCollisionFree();
 			
+			using Sampler::generateCollisionFree;
+			
 			virtual void seed(const ::std::mt19937::result_type& value);
 			
 			::rl::math::Vector* sigma;
@@ -24,6 +24,8 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
+
 #include "LinearNearestNeighbors.h"
 #include "Model.h"
 
@@ -33,7 +35,9 @@ namespace rl
 	{
 		LinearNearestNeighbors::LinearNearestNeighbors(Model* model) :
 			NearestNeighbors(true),
-			container(Metric(model, true))
+			configurations(),
+			metric(model, true),
+			values()
 		{
 		}
 		
@@ -44,37 +48,97 @@ namespace rl
 		void
 		LinearNearestNeighbors::clear()
 		{
-			this->container.clear();
+			this->values.clear();
 		}
 		
 		bool
 		LinearNearestNeighbors::empty() const
 		{
-			return this->container.empty();
+			return this->values.empty();
 		}
 		
 		::std::vector<NearestNeighbors::Neighbor>
 		LinearNearestNeighbors::nearest(const NearestNeighbors::Value& query, const ::std::size_t& k, const bool& sorted) const
 		{
-			return this->container.nearest(query, k, sorted);
+			return this->search(query, &k, nullptr, sorted);
 		}
 		
 		void
 		LinearNearestNeighbors::push(const NearestNeighbors::Value& value)
 		{
-			this->container.push(value);
+			if (this->values.empty())
+			{
+				this->configurations.resize(value.first->size(), ::std::max<::std::ptrdiff_t>(16, this->configurations.cols()));
+			}
+			else if (static_cast<::std::size_t>(this->configurations.cols()) == this->values.size())
+			{
+				this->configurations.conservativeResize(::Eigen::NoChange, 2 * this->configurations.cols());
+			}
+			
+			this->configurations.col(this->values.size()) = *value.first;
+			this->values.push_back(value);
 		}
 		
 		::std::vector<NearestNeighbors::Neighbor>
 		LinearNearestNeighbors::radius(const NearestNeighbors::Value& query, const Distance& radius, const bool& sorted) const
 		{
-			return this->container.radius(query, radius, sorted);
+			return this->search(query, nullptr, &radius, sorted);
+		}
+		
+		::std::vector<NearestNeighbors::Neighbor>
+		LinearNearestNeighbors::search(const NearestNeighbors::Value& query, const ::std::size_t* k, const Distance* radius, const bool& sorted) const
+		{
+			::std::vector<Neighbor> neighbors;
+			
+			if (this->values.empty())
+			{
+				return neighbors;
+			}
+			
+			if (nullptr != k)
+			{
+				neighbors.reserve(::std::min(*k, this->values.size()));
+			}
+			
+			::rl::math::Vector distances;
+			this->metric(*query.first, this->configurations.leftCols(this->values.size()), distances);
+			
+			for (::std::size_t i = 0; i < this->values.size(); ++i)
+			{
+				if (nullptr == k || neighbors.size() < *k || distances(i) < neighbors.front().first)
+				{
+					if (nullptr == radius || distances(i) < *radius)
+					{
+						if (nullptr != k && *k == neighbors.size())
+						{
+							::std::pop_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+							neighbors.pop_back();
+						}
+						
+						neighbors.emplace_back(distances(i), this->values[i]);
+						::std::push_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+					}
+				}
+			}
+			
+			if (sorted)
+			{
+				::std::sort_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+			}
+			
+			return neighbors;
 		}
 		
 		::std::size_t
 		LinearNearestNeighbors::size() const
 		{
-			return this->container.size();
+			return this->values.size();
+		}
+		
+		bool
+		LinearNearestNeighbors::NeighborCompare::operator()(const Neighbor& lhs, const Neighbor& rhs) const
+		{
+			return lhs.first < rhs.first;
 		}
 	}
 }
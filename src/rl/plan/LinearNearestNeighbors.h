@@ -27,7 +27,7 @@
 #ifndef RL_PLAN_LINEARNEARESTNEIGHBORS_H
 #define RL_PLAN_LINEARNEARESTNEIGHBORS_H
 
-#include <rl/math/LinearNearestNeighbors.h>
+#include <rl/math/Matrix.h>
 
 #include "NearestNeighbors.h"
 
@@ -37,6 +37,12 @@ namespace rl
 	{
 		class Model;
 		
+		/**
+		 * Linear nearest neighbor search.
+		 *
+		 * Configurations are copied into the columns of one matrix, so distances
+		 * to all of them are evaluated as one block of the metric.
+		 */
 		class RL_PLAN_EXPORT LinearNearestNeighbors : public NearestNeighbors
 		{
 		public:
@@ -59,7 +65,18 @@ namespace rl
 		protected:
 			
 		private:
-			::rl::math::LinearNearestNeighbors<Metric> container;
+			struct NeighborCompare
+			{
+				bool operator()(const Neighbor& lhs, const Neighbor& rhs) const;
+			};
+			
+			::std::vector<NearestNeighbors::Neighbor> search(const NearestNeighbors::Value& query, const ::std::size_t* k, const Distance* radius, const bool& sorted) const;
+			
+			::rl::math::Matrix configurations;
+			
+			Metric metric;
+			
+			::std::vector<NearestNeighbors::Value> values;
 		};
 	}
 }
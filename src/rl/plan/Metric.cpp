@@ -24,26 +24,123 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <cmath>
+#include <typeinfo>
+#include <rl/mdl/Cylindrical.h>
+#include <rl/mdl/Helical.h>
+#include <rl/mdl/Prismatic.h>
+#include <rl/mdl/Revolute.h>
+
+#include "DistanceModel.h"
 #include "Metric.h"
 #include "Model.h"
+#include "SimpleModel.h"
 
 namespace rl
 {
 	namespace plan
 	{
 		Metric::Metric(Model* model, const bool& transformed) :
+			coordinates(),
 			model(model),
-			transformed(transformed)
+			transformed(transformed),
+			vectorized(false)
 		{
+			if (nullptr == model)
+			{
+				return;
+			}
+			
+			// derived models may override transformedDistance()
+			if (typeid(*model) != typeid(Model) && typeid(*model) != typeid(SimpleModel) && typeid(*model) != typeid(DistanceModel))
+			{
+				return;
+			}
+			
+			if (nullptr != model->kin)
+			{
+				for (::std::size_t i = 0; i < model->kin->getDof(); ++i)
+				{
+					this->coordinates.push_back(::std::make_pair(i, i));
+				}
+				
+				this->vectorized = true;
+			}
+			else if (nullptr != model->mdl)
+			{
+				this->vectorized = true;
+				
+				for (::std::size_t i = 0, j = 0; i < model->mdl->getJoints(); j += model->mdl->getJoint(i)->getDofPosition(), ++i)
+				{
+					::rl::mdl::Joint* joint = model->mdl->getJoint(i);
+					
+					if (typeid(*joint) == typeid(::rl::mdl::Revolute))
+					{
+						this->coordinates.push_back(::std::make_pair(i, j));
+					}
+					else if (typeid(*joint) != typeid(::rl::mdl::Cylindrical) && typeid(*joint) != typeid(::rl::mdl::Helical) && typeid(*joint) != typeid(::rl::mdl::Prismatic))
+					{
+						this->vectorized = false;
+					}
+				}
+			}
 		}
 		
 		Metric::~Metric()
 		{
 		}
 		
+		bool
+		Metric::getRange(const ::std::size_t& i, ::rl::math::Real& range) const
+		{
+			if (nullptr != this->model->kin)
+			{
+				if (!this->model->kin->getWraparound(this->coordinates[i].first))
+				{
+					return false;
+				}
+				
+				range = ::std::abs(this->model->kin->getMaximum(this->coordinates[i].first) - this->model->kin->getMinimum(this->coordinates[i].first));
+			}
+			else
+			{
+				::rl::mdl::Joint* joint = this->model->mdl->getJoint(this->coordinates[i].first);
+				
+				if (!joint->wraparound(0))
+				{
+					return false;
+				}
+				
+				range = ::std::abs(joint->max(0) - joint->min(0));
+			}
+			
+			return true;
+		}
+		
 		Metric::Distance
 		Metric::operator()(const Value& lhs, const Value& rhs) const
 		{
+			if (this->vectorized)
+			{
+				::Eigen::Map<const ::rl::math::ArrayX> q1(lhs.first->data(), lhs.first->size());
+				::Eigen::Map<const ::rl::math::ArrayX> q2(rhs.first->data(), rhs.first->size());
+				
+				Distance d = (q1 - q2).square().sum();
+				
+				for (::std::size_t i = 0; i < this->coordinates.size(); ++i)
+				{
+					::rl::math::Real range;
+					
+					if (this->getRange(i, range))
+					{
+						::rl::math::Real delta = ::std::abs(q1(this->coordinates[i].second) - q2(this->coordinates[i].second));
+						d += ::std::pow(::std::min(delta, ::std::abs(range - delta)), 2) - ::std::pow(delta, 2);
+					}
+				}
+				
+				return this->transformed ? d : ::std::sqrt(d);
+			}
+			
 			if (this->transformed)
 			{
 				return this->model->transformedDistance(*lhs.first, *rhs.first);
@@ -60,6 +157,47 @@ namespace rl
 			return this->model->transformedDistance(lhs, rhs, index);
 		}
 		
+		void
+		Metric::operator()(const ::rl::math::Vector& query, const ::rl::math::ConstMatrixRef& values, ::rl::math::Vector& distances) const
+		{
+			distances.resize(values.cols());
+			
+			if (this->vectorized)
+			{
+				distances = (values.colwise() - query).colwise().squaredNorm().transpose();
+				
+				for (::std::size_t i = 0; i < this->coordinates.size(); ++i)
+				{
+					::rl::math::Real range;
+					
+					if (this->getRange(i, range))
+					{
+						::rl::math::ArrayX delta = (values.row(this->coordinates[i].second).transpose().array() - query(this->coordinates[i].second)).abs();
+						distances.array() += delta.min((range - delta).abs()).square() - delta.square();
+					}
+				}
+				
+				if (!this->transformed)
+				{
+					distances = distances.cwiseSqrt();
+				}
+				
+				return;
+			}
+			
+			for (::std::ptrdiff_t i = 0; i < values.cols(); ++i)
+			{
+				if (this->transformed)
+				{
+					distances(i) = this->model->transformedDistance(query, values.col(i));
+				}
+				else
+				{
+					distances(i) = this->model->distance(query, values.col(i));
+				}
+			}
+		}
+		
 		Metric::Value::Value() :
 			first(),
 			second()
@@ -27,6 +27,10 @@
 #ifndef RL_PLAN_METRIC_H
 #define RL_PLAN_METRIC_H
 
+#include <utility>
+#include <vector>
+#include <rl/math/Array.h>
+#include <rl/math/Matrix.h>
 #include <rl/math/Real.h>
 #include <rl/math/Vector.h>
 #include <rl/plan/export.h>
@@ -37,6 +41,16 @@ namespace rl
 	{
 		class Model;
 		
+		/**
+		 * Configuration space metric for nearest neighbor search.
+		 *
+		 * For models whose joints all measure distance as a sum of squared
+		 * coordinate differences with optional wraparound, distances are evaluated
+		 * as one vectorized expression instead of per-joint virtual calls. Joint
+		 * limits and wraparound flags are read on every evaluation, only the
+		 * joint types are determined at construction. Derived models that may
+		 * override Model::transformedDistance() always use it.
+		 */
 		class RL_PLAN_EXPORT Metric
 		{
 		public:
@@ -71,12 +85,34 @@ namespace rl
 			
 			Distance operator()(const Distance& lhs, const Distance& rhs, const ::std::size_t& index) const;
 			
+			/**
+			 * Distances between a query and a block of configurations.
+			 *
+			 * @param[in] values Configurations, one per column
+			 * @param[out] distances Distance per column
+			 */
+			void operator()(const ::rl::math::Vector& query, const ::rl::math::ConstMatrixRef& values, ::rl::math::Vector& distances) const;
+			
 		protected:
 			
 		private:
+			/**
+			 * Current wraparound range of a coordinate.
+			 *
+			 * @param[in] i Index into #coordinates
+			 * @return False if coordinate does not wrap around
+			 */
+			bool getRange(const ::std::size_t& i, ::rl::math::Real& range) const;
+			
+			/** Joint and position index of coordinates that may wrap around. */
+			::std::vector<::std::pair<::std::size_t, ::std::size_t>> coordinates;
+			
 			Model* model;
 			
 			bool transformed;
+			
+			/** Distances are evaluated element-wise on coordinates. */
+			bool vectorized;
 		};
 	}
 }
@@ -24,6 +24,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <limits>
 #include <rl/sg/Body.h>
 
 #include "Model.h"
@@ -36,7 +37,8 @@ namespace rl
 			kin(nullptr),
 			mdl(nullptr),
 			model(nullptr),
-			scene(nullptr)
+			scene(nullptr),
+			revisions()
 		{
 		}
 		
@@ -525,9 +527,16 @@ namespace rl
 				
 				if (doUpdateModel)
 				{
+					this->revisions.resize(this->model->getNumBodies(), ::std::numeric_limits<::std::size_t>::max());
+					
 					for (::std::size_t i = 0; i < this->model->getNumBodies(); ++i)
 					{
-						this->model->getBody(i)->setFrame(this->mdl->getBodyFrame(i));
+						// only pass recalculated frames to the scene graph
+						if (this->mdl->getBodyFrameRevision(i) != this->revisions[i])
+						{
+							this->model->getBody(i)->setFrame(this->mdl->getBodyFrame(i));
+							this->revisions[i] = this->mdl->getBodyFrameRevision(i);
+						}
 					}
 				}
 			}
@@ -27,6 +27,7 @@
 #ifndef RL_PLAN_MODEL_H
 #define RL_PLAN_MODEL_H
 
+#include <vector>
 #include <rl/kin/Kinematics.h>
 #include <rl/math/Transform.h>
 #include <rl/math/Vector.h>
@@ -118,6 +119,14 @@ namespace rl
 			
 			virtual ::rl::math::Real transformedDistance(const ::rl::math::Real& q1, const ::rl::math::Real& q2, const ::std::size_t& i) const;
 			
+			/**
+			 * Update the frames of the kinematic model.
+			 *
+			 * With doUpdateModel, body frames of an rl::mdl::Kinematic model are only
+			 * passed to the scene graph model if they were recalculated since the
+			 * last call, frames of the scene graph model modified elsewhere are not
+			 * restored.
+			 */
 			virtual void updateFrames(const bool& doUpdateModel = true);
 			
 			virtual void updateJacobian();
@@ -135,7 +144,10 @@ namespace rl
 		protected:
 			
 		private:
-			
+			/**
+			 * Body frame revisions last passed to the scene graph model.
+			 */
+			::std::vector<::std::size_t> revisions;
 		};
 	}
 }
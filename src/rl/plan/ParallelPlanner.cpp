@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "ParallelPlanner.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		ParallelPlanner::ParallelPlanner() :
+			Planner(),
+			planners(),
+			pool(),
+			solver(0)
+		{
+		}
+		
+		ParallelPlanner::~ParallelPlanner()
+		{
+		}
+		
+		void
+		ParallelPlanner::cancel()
+		{
+			Planner::cancel();
+			
+			for (::std::size_t i = 0; i < this->planners.size(); ++i)
+			{
+				this->planners[i]->cancel();
+			}
+		}
+		
+		::std::string
+		ParallelPlanner::getName() const
+		{
+			return "Parallel";
+		}
+		
+		VectorList
+		ParallelPlanner::getPath()
+		{
+			Planner* solver = this->getSolver();
+			
+			if (nullptr == solver)
+			{
+				return VectorList();
+			}
+			
+			return solver->getPath();
+		}
+		
+		Planner*
+		ParallelPlanner::getSolver() const
+		{
+			::std::size_t solver = this->solver;
+			return solver < this->planners.size() ? this->planners[solver] : nullptr;
+		}
+		
+		void
+		ParallelPlanner::reset()
+		{
+			for (::std::size_t i = 0; i < this->planners.size(); ++i)
+			{
+				this->planners[i]->reset();
+			}
+			
+			this->canceled = false;
+			this->solver = this->planners.size();
+		}
+		
+		bool
+		ParallelPlanner::solve()
+		{
+			this->time = ::std::chrono::steady_clock::now();
+			this->solver = this->planners.size();
+			
+			if (this->planners.empty())
+			{
+				return false;
+			}
+			
+			for (::std::size_t i = 0; i < this->planners.size(); ++i)
+			{
+				this->planners[i]->duration = this->duration;
+				this->planners[i]->goal = this->goal;
+				this->planners[i]->start = this->start;
+			}
+			
+			if (nullptr == this->pool || this->pool->size() != this->planners.size())
+			{
+				this->pool.reset(new ::rl::util::thread_pool(this->planners.size()));
+			}
+			
+			this->pool->run([this](const ::std::size_t& i) {
+				// cancel requests remain until reset, so late starters return immediately
+				if (this->planners[i]->solve())
+				{
+					::std::size_t none = this->planners.size();
+					
+					if (this->solver.compare_exchange_strong(none, i))
+					{
+						for (::std::size_t j = 0; j < this->planners.size(); ++j)
+						{
+							if (i != j)
+							{
+								this->planners[j]->cancel();
+							}
+						}
+					}
+				}
+			});
+			
+			return nullptr != this->getSolver();
+		}
+	}
+}
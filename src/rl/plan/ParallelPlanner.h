@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_PARALLELPLANNER_H
+#define RL_PLAN_PARALLELPLANNER_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <rl/util/thread_pool.h>
+
+#include "Planner.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		/**
+		 * OR-parallel planning with independent planners.
+		 *
+		 * All planners run concurrently on the same query, one per thread. The
+		 * first one to find a path wins and cancels the others. With randomized
+		 * planners such as RrtConCon or RrtExtCon, this cuts the heavy tail of
+		 * the runtime distribution.
+		 *
+		 * Each planner requires its own tree, sampler, and model. Use a
+		 * CollisionContext of a common SimpleModel as model of each planner and
+		 * its sampler, and seed the samplers differently. Start, goal, and
+		 * duration are passed on to all planners by solve().
+		 */
+		class RL_PLAN_EXPORT ParallelPlanner : public Planner
+		{
+		public:
+			ParallelPlanner();
+			
+			virtual ~ParallelPlanner();
+			
+			void cancel();
+			
+			::std::string getName() const;
+			
+			/**
+			 * Get solution path of the winning planner.
+			 *
+			 * @pre solve()
+			 */
+			VectorList getPath();
+			
+			/**
+			 * Planner that found the path in the last call to solve().
+			 *
+			 * @return nullptr if no planner found a path
+			 */
+			Planner* getSolver() const;
+			
+			void reset();
+			
+			bool solve();
+			
+			/** Planners to run concurrently. */
+			::std::vector<Planner*> planners;
+			
+		protected:
+			
+		private:
+			::std::unique_ptr<::rl::util::thread_pool> pool;
+			
+			::std::atomic<::std::size_t> solver;
+		};
+	}
+}
+
+#endif // RL_PLAN_PARALLELPLANNER_H
@@ -33,6 +33,7 @@ namespace rl
 	namespace plan
 	{
 		Planner::Planner() :
+			canceled(false),
 			duration(::std::chrono::steady_clock::duration::max()),
 			goal(nullptr),
 			model(nullptr),
@@ -46,6 +47,24 @@ namespace rl
 		{
 		}
 		
+		void
+		Planner::cancel()
+		{
+			this->canceled = true;
+		}
+		
+		bool
+		Planner::isCanceled() const
+		{
+			return this->canceled;
+		}
+		
+		bool
+		Planner::isExpired() const
+		{
+			return this->canceled || (::std::chrono::steady_clock::now() - this->time) >= this->duration;
+		}
+		
 		bool
 		Planner::verify()
 		{
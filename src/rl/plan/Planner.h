@@ -27,6 +27,7 @@
 #ifndef RL_PLAN_PLANNER_H
 #define RL_PLAN_PLANNER_H
 
+#include <atomic>
 #include <chrono>
 #include <string>
 #include <rl/math/Vector.h>
@@ -51,6 +52,13 @@ namespace rl
 			
 			virtual ~Planner();
 			
+			/**
+			 * Request a running solve() to return as soon as possible.
+			 *
+			 * May be called from any thread. The request remains until reset().
+			 */
+			virtual void cancel();
+			
 			virtual ::std::string getName() const = 0;
 			
 			/**
@@ -60,6 +68,11 @@ namespace rl
 			 */
 			virtual VectorList getPath() = 0;
 			
+			/**
+			 * Check if cancel() was called since the last reset().
+			 */
+			bool isCanceled() const;
+			
 			/**
 			 * Reset planner.
 			 */
@@ -89,6 +102,13 @@ namespace rl
 			Viewer* viewer;
 			
 		protected:
+			/**
+			 * Check if search should stop due to cancel() or duration.
+			 */
+			bool isExpired() const;
+			
+			::std::atomic<bool> canceled;
+			
 			::std::chrono::steady_clock::time_point time;
 			
 		private:
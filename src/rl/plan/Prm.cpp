@@ -24,10 +24,22 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
+#include <fstream>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <boost/graph/incremental_components.hpp>
+#include <rl/kin/Joint.h>
+#include <rl/kin/Kinematics.h>
+#include <rl/mdl/Fixed.h>
+#include <rl/mdl/Joint.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/sg/Body.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/Scene.h>
+#include <rl/sg/Shape.h>
 
 #include "BridgeSampler.h"
+#include "Exception.h"
 #include "GaussianSampler.h"
 #include "Prm.h"
 #include "Sampler.h"
@@ -40,14 +52,21 @@ namespace rl
 {
 	namespace plan
 	{
+		const char Prm::magic[8] = {'r', 'l', 'p', 'r', 'm', '\0', '\0', '\0'};
+		
+		const ::std::uint32_t Prm::version = 2;
+		
 		Prm::Prm() :
 			Planner(),
 			astar(true),
+			batch(1),
 			degree(::std::numeric_limits<::std::size_t>::max()),
 			k(30),
+			lazy(false),
 			radius(::std::numeric_limits<::rl::math::Real>::max()),
 			sampler(nullptr),
 			verifier(nullptr),
+			arena(),
 			begin(nullptr),
 			ds(
 				::boost::get(&VertexBundle::rank, graph),
@@ -66,6 +85,7 @@ namespace rl
 		Prm::addEdge(const Vertex& u, const Vertex& v, const ::rl::math::Real& weight)
 		{
 			Edge e = ::boost::add_edge(u, v, this->graph).first;
+			this->graph[e].verified = !this->lazy;
 			this->graph[e].weight = weight;
 			
 			this->ds.union_set(u, v);
@@ -97,13 +117,129 @@ namespace rl
 		void
 		Prm::construct(const ::std::size_t& steps)
 		{
-			for (::std::size_t i = 0; i < steps; ++i)
+			if (this->batch < 2)
+			{
+				for (::std::size_t i = 0; i < steps; ++i)
+				{
+					VectorPtr q = this->arena.makeShared<::rl::math::Vector>(this->model->getDofPosition());
+					*q = this->sampler->generateCollisionFree();
+					Vertex v = this->addVertex(q);
+					this->insert(v);
+				}
+				
+				return;
+			}
+			
+			::rl::math::Matrix q;
+			::std::vector<Vertex> vertices;
+			
+			for (::std::size_t i = 0; i < steps; i += this->batch)
+			{
+				this->sampler->generateCollisionFree(::std::min(this->batch, steps - i), q);
+				
+				vertices.clear();
+				
+				for (::std::ptrdiff_t j = 0; j < q.cols(); ++j)
+				{
+					vertices.push_back(this->addVertex(this->arena.makeShared<::rl::math::Vector>(q.col(j))));
+				}
+				
+				this->insert(vertices);
+			}
+		}
+		
+		::std::uint64_t
+		Prm::getFingerprint() const
+		{
+			::std::uint64_t value = 14695981039346656037ULL;
+			
+			::std::string name = this->model->getName();
+			Prm::hash(name.data(), name.size(), value);
+			
+			::std::uint64_t dof = this->model->getDofPosition();
+			Prm::hash(&dof, sizeof(dof), value);
+			
+			::rl::math::Vector maximum = this->model->getMaximum();
+			Prm::hash(maximum.data(), maximum.size() * sizeof(::rl::math::Real), value);
+			
+			::rl::math::Vector minimum = this->model->getMinimum();
+			Prm::hash(minimum.data(), minimum.size() * sizeof(::rl::math::Real), value);
+			
+			::rl::math::Transform transform;
+			
+			if (nullptr != this->model->kin)
+			{
+				transform = this->model->kin->world();
+				Prm::hash(transform.data(), 16 * sizeof(::rl::math::Real), value);
+				
+				for (::std::size_t i = 0; i < this->model->kin->getDof(); ++i)
+				{
+					::rl::kin::Joint* joint = this->model->kin->getJoint(i);
+					::rl::math::Real parameters[] = {joint->a, joint->alpha, joint->d, joint->offset, joint->theta};
+					Prm::hash(parameters, sizeof(parameters), value);
+				}
+				
+				for (::std::size_t i = 0; i < this->model->kin->getOperationalDof(); ++i)
+				{
+					transform = this->model->kin->tool(i);
+					Prm::hash(transform.data(), 16 * sizeof(::rl::math::Real), value);
+				}
+			}
+			else if (nullptr != this->model->mdl)
+			{
+				transform = static_cast<const ::rl::mdl::Model*>(this->model->mdl)->world();
+				Prm::hash(transform.data(), 16 * sizeof(::rl::math::Real), value);
+				
+				for (::std::size_t i = 0; i < this->model->mdl->getTransforms(); ++i)
+				{
+					if (::rl::mdl::Fixed* fixed = dynamic_cast<::rl::mdl::Fixed*>(this->model->mdl->getTransform(i)))
+					{
+						transform = fixed->x.transform();
+						Prm::hash(transform.data(), 16 * sizeof(::rl::math::Real), value);
+					}
+					else if (::rl::mdl::Joint* joint = dynamic_cast<::rl::mdl::Joint*>(this->model->mdl->getTransform(i)))
+					{
+						Prm::hash(joint->S.data(), joint->S.size() * sizeof(::rl::math::Real), value);
+						Prm::hash(joint->offset.data(), joint->offset.size() * sizeof(::rl::math::Real), value);
+					}
+				}
+			}
+			
+			if (nullptr != this->verifier)
+			{
+				Prm::hash(&this->verifier->delta, sizeof(::rl::math::Real), value);
+			}
+			
+			if (nullptr != this->model->scene)
 			{
-				VectorPtr q = ::std::make_shared<::rl::math::Vector>(this->model->getDofPosition());
-				*q = this->sampler->generateCollisionFree();
-				Vertex v = this->addVertex(q);
-				this->insert(v);
+				for (::rl::sg::Scene::Iterator i = this->model->scene->begin(); i != this->model->scene->end(); ++i)
+				{
+					name = (*i)->getName();
+					Prm::hash(name.data(), name.size(), value);
+					
+					for (::rl::sg::Model::Iterator j = (*i)->begin(); j != (*i)->end(); ++j)
+					{
+						name = (*j)->getName();
+						Prm::hash(name.data(), name.size(), value);
+						
+						if (this->model->model != *i)
+						{
+							(*j)->getFrame(transform);
+							Prm::hash(transform.data(), 16 * sizeof(::rl::math::Real), value);
+						}
+						
+						for (::rl::sg::Body::Iterator k = (*j)->begin(); k != (*j)->end(); ++k)
+						{
+							name = (*k)->getName();
+							Prm::hash(name.data(), name.size(), value);
+							(*k)->getTransform(transform);
+							Prm::hash(transform.data(), 16 * sizeof(::rl::math::Real), value);
+						}
+					}
+				}
 			}
+			
+			return value;
 		}
 		
 		::std::string
@@ -121,6 +257,11 @@ namespace rl
 				}
 			}
 			
+			if (this->lazy)
+			{
+				return "Lazy PRM";
+			}
+			
 			return "PRM";
 		}
 		
@@ -160,6 +301,18 @@ namespace rl
 			return path;
 		}
 		
+		void
+		Prm::hash(const void* data, const ::std::size_t& size, ::std::uint64_t& value)
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			
+			for (::std::size_t i = 0; i < size; ++i)
+			{
+				value ^= bytes[i];
+				value *= 1099511628211ULL;
+			}
+		}
+		
 		void
 		Prm::insert(const Vertex& v)
 		{
@@ -175,7 +328,11 @@ namespace rl
 					
 					if (d < this->radius)
 					{
-						if (!::boost::same_component(u, v, this->ds))
+						if (this->lazy)
+						{
+							this->addEdge(u, v, d);
+						}
+						else if (!::boost::same_component(u, v, this->ds))
 						{
 							if (!this->verifier->isColliding(*this->graph[u].q, *this->graph[v].q, d))
 							{
@@ -189,42 +346,275 @@ namespace rl
 			this->graph[::boost::graph_bundle].nn->push(Metric::Value(this->graph[v].q.get(), v));
 		}
 		
+		void
+		Prm::insert(const ::std::vector<Vertex>& vertices)
+		{
+			for (::std::size_t i = 0; i < vertices.size(); ++i)
+			{
+				this->graph[::boost::graph_bundle].nn->push(Metric::Value(this->graph[vertices[i]].q.get(), vertices[i]));
+			}
+			
+			::std::vector<::std::pair<Vertex, Vertex>> candidates;
+			::std::vector<::rl::math::Real> distances;
+			::std::vector<const ::rl::math::Vector*> first;
+			::std::vector<const ::rl::math::Vector*> second;
+			
+			for (::std::size_t i = 0; i < vertices.size(); ++i)
+			{
+				Vertex v = vertices[i];
+				
+				::std::vector<Neighbor> neighbors = this->graph[::boost::graph_bundle].nn->nearest(Metric::Value(this->graph[v].q.get(), v), this->k + 1);
+				
+				for (::std::size_t j = 0; j < neighbors.size(); ++j)
+				{
+					Vertex u = neighbors[j].second.second;
+					
+					if (this->graph[u].index < this->graph[v].index && ::boost::degree(u, this->graph) < this->degree)
+					{
+						::rl::math::Real d = this->graph[::boost::graph_bundle].nn->isTransformedDistance() ? this->model->inverseOfTransformedDistance(neighbors[j].first) : neighbors[j].first;
+						
+						if (d < this->radius)
+						{
+							if (this->lazy || !::boost::same_component(u, v, this->ds))
+							{
+								candidates.push_back(::std::make_pair(u, v));
+								distances.push_back(d);
+								first.push_back(this->graph[u].q.get());
+								second.push_back(this->graph[v].q.get());
+							}
+						}
+					}
+				}
+			}
+			
+			::Eigen::Matrix<bool, ::Eigen::Dynamic, 1> colliding = ::Eigen::Matrix<bool, ::Eigen::Dynamic, 1>::Constant(candidates.size(), false);
+			
+			if (!this->lazy)
+			{
+				this->verifier->isColliding(first, second, distances, colliding);
+			}
+			
+			for (::std::size_t i = 0; i < candidates.size(); ++i)
+			{
+				Vertex u = candidates[i].first;
+				Vertex v = candidates[i].second;
+				
+				if (!colliding(i) && ::boost::degree(u, this->graph) < this->degree && ::boost::degree(v, this->graph) < this->degree)
+				{
+					if (this->lazy || !::boost::same_component(u, v, this->ds))
+					{
+						this->addEdge(u, v, distances[i]);
+					}
+				}
+			}
+		}
+		
+		void
+		Prm::load(const ::std::string& filename)
+		{
+			::std::ifstream stream(filename.c_str(), ::std::ios::binary);
+			
+			if (!stream)
+			{
+				throw Exception("rl::plan::Prm::load() - Could not open file " + filename);
+			}
+			
+			char magic[sizeof(Prm::magic)];
+			::std::uint32_t version = 0;
+			::std::uint32_t precision = 0;
+			::std::uint64_t fingerprint = 0;
+			::std::uint64_t dof = 0;
+			::std::uint64_t numVertices = 0;
+			::std::uint64_t numEdges = 0;
+			
+			stream.read(magic, sizeof(magic));
+			stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+			stream.read(reinterpret_cast<char*>(&precision), sizeof(precision));
+			stream.read(reinterpret_cast<char*>(&fingerprint), sizeof(fingerprint));
+			stream.read(reinterpret_cast<char*>(&dof), sizeof(dof));
+			stream.read(reinterpret_cast<char*>(&numVertices), sizeof(numVertices));
+			stream.read(reinterpret_cast<char*>(&numEdges), sizeof(numEdges));
+			
+			if (!stream || !::std::equal(magic, magic + sizeof(magic), Prm::magic))
+			{
+				throw Exception("rl::plan::Prm::load() - Invalid file format");
+			}
+			
+			if (Prm::version != version)
+			{
+				throw Exception("rl::plan::Prm::load() - Unsupported file version");
+			}
+			
+			if (sizeof(::rl::math::Real) != precision)
+			{
+				throw Exception("rl::plan::Prm::load() - Incompatible floating point precision");
+			}
+			
+			if (this->model->getDofPosition() != dof)
+			{
+				throw Exception("rl::plan::Prm::load() - Incompatible number of degrees of freedom");
+			}
+			
+			if (this->getFingerprint() != fingerprint)
+			{
+				throw Exception("rl::plan::Prm::load() - Roadmap does not match model or scene");
+			}
+			
+			::std::streampos position = stream.tellg();
+			stream.seekg(0, ::std::ios::end);
+			::std::uint64_t remaining = stream.tellg() - position;
+			stream.seekg(position);
+			
+			::std::uint64_t vertexSize = dof * sizeof(::rl::math::Real) + sizeof(::std::uint64_t);
+			::std::uint64_t edgeSize = 2 * sizeof(::std::uint64_t) + sizeof(::rl::math::Real) + sizeof(::std::uint8_t);
+			
+			if (!stream || numVertices > remaining / vertexSize || numEdges > remaining / edgeSize || numVertices * vertexSize + numEdges * edgeSize != remaining)
+			{
+				throw Exception("rl::plan::Prm::load() - Number of vertices and edges does not match file size");
+			}
+			
+			::rl::math::Matrix q(dof, numVertices);
+			stream.read(reinterpret_cast<char*>(q.data()), q.size() * sizeof(::rl::math::Real));
+			
+			::std::vector<::std::uint64_t> components(numVertices);
+			stream.read(reinterpret_cast<char*>(components.data()), components.size() * sizeof(::std::uint64_t));
+			
+			if (!stream)
+			{
+				throw Exception("rl::plan::Prm::load() - Unexpected end of file");
+			}
+			
+			::std::vector<::std::pair<::std::uint64_t, ::std::uint64_t>> edges(numEdges);
+			::std::vector<::std::uint8_t> verified(numEdges);
+			::std::vector<::rl::math::Real> weights(numEdges);
+			
+			for (::std::size_t i = 0; i < numEdges; ++i)
+			{
+				stream.read(reinterpret_cast<char*>(&edges[i].first), sizeof(::std::uint64_t));
+				stream.read(reinterpret_cast<char*>(&edges[i].second), sizeof(::std::uint64_t));
+				stream.read(reinterpret_cast<char*>(&weights[i]), sizeof(::rl::math::Real));
+				stream.read(reinterpret_cast<char*>(&verified[i]), sizeof(::std::uint8_t));
+			}
+			
+			if (!stream)
+			{
+				throw Exception("rl::plan::Prm::load() - Unexpected end of file");
+			}
+			
+			for (::std::size_t i = 0; i < numVertices; ++i)
+			{
+				if (components[i] >= numVertices)
+				{
+					throw Exception("rl::plan::Prm::load() - Invalid component index");
+				}
+			}
+			
+			for (::std::size_t i = 0; i < numEdges; ++i)
+			{
+				if (edges[i].first >= numVertices || edges[i].second >= numVertices)
+				{
+					throw Exception("rl::plan::Prm::load() - Invalid vertex index");
+				}
+			}
+			
+			this->reset();
+			
+			::std::vector<Vertex> vertices(numVertices);
+			
+			for (::std::size_t i = 0; i < numVertices; ++i)
+			{
+				vertices[i] = this->addVertex(this->arena.makeShared<::rl::math::Vector>(q.col(i)));
+				this->graph[::boost::graph_bundle].nn->push(Metric::Value(this->graph[vertices[i]].q.get(), vertices[i]));
+			}
+			
+			for (::std::size_t i = 0; i < numVertices; ++i)
+			{
+				this->ds.union_set(vertices[i], vertices[components[i]]);
+			}
+			
+			for (::std::size_t i = 0; i < numEdges; ++i)
+			{
+				Edge e = ::boost::add_edge(vertices[edges[i].first], vertices[edges[i].second], this->graph).first;
+				this->graph[e].verified = verified[i];
+				this->graph[e].weight = weights[i];
+				
+				if (nullptr != this->viewer)
+				{
+					this->viewer->drawConfigurationEdge(*this->graph[vertices[edges[i].first]].q, *this->graph[vertices[edges[i].second]].q);
+				}
+			}
+		}
+		
 		void
 		Prm::reset()
 		{
 			this->graph.clear();
 			this->graph[::boost::graph_bundle].nn->clear();
+			this->arena.clear();
 			this->begin = nullptr;
 			this->end = nullptr;
+			this->canceled = false;
 		}
 		
 		void
-		Prm::setNearestNeighbors(NearestNeighbors* nearestNeighbors)
+		Prm::save(const ::std::string& filename)
 		{
-			this->graph[::boost::graph_bundle].nn = nearestNeighbors;
-		}
-		
-		bool
-		Prm::solve()
-		{
-			this->time = ::std::chrono::steady_clock::now();
+			::std::ofstream stream(filename.c_str(), ::std::ios::binary);
 			
-			this->begin = this->addVertex(::std::make_shared<::rl::math::Vector>(*this->start));
-			this->insert(this->begin);
+			if (!stream)
+			{
+				throw Exception("rl::plan::Prm::save() - Could not open file " + filename);
+			}
 			
-			this->end = this->addVertex(::std::make_shared<::rl::math::Vector>(*this->goal));
-			this->insert(this->end);
+			::std::uint32_t precision = sizeof(::rl::math::Real);
+			::std::uint64_t fingerprint = this->getFingerprint();
+			::std::uint64_t dof = this->model->getDofPosition();
+			::std::uint64_t numVertices = ::boost::num_vertices(this->graph);
+			::std::uint64_t numEdges = ::boost::num_edges(this->graph);
+			
+			stream.write(Prm::magic, sizeof(Prm::magic));
+			stream.write(reinterpret_cast<const char*>(&Prm::version), sizeof(Prm::version));
+			stream.write(reinterpret_cast<const char*>(&precision), sizeof(precision));
+			stream.write(reinterpret_cast<const char*>(&fingerprint), sizeof(fingerprint));
+			stream.write(reinterpret_cast<const char*>(&dof), sizeof(dof));
+			stream.write(reinterpret_cast<const char*>(&numVertices), sizeof(numVertices));
+			stream.write(reinterpret_cast<const char*>(&numEdges), sizeof(numEdges));
 			
-			while ((::std::chrono::steady_clock::now() - this->time) < this->duration && !::boost::same_component(this->begin, this->end, this->ds))
+			VertexIteratorPair vertices = ::boost::vertices(this->graph);
+			
+			for (VertexIterator i = vertices.first; i != vertices.second; ++i)
 			{
-				this->construct(1);
+				stream.write(reinterpret_cast<const char*>(this->graph[*i].q->data()), dof * sizeof(::rl::math::Real));
 			}
 			
-			if (!::boost::same_component(this->begin, this->end, this->ds))
+			for (VertexIterator i = vertices.first; i != vertices.second; ++i)
 			{
-				return false;
+				::std::uint64_t component = this->graph[this->ds.find_set(*i)].index;
+				stream.write(reinterpret_cast<const char*>(&component), sizeof(component));
+			}
+			
+			EdgeIteratorPair edges = ::boost::edges(this->graph);
+			
+			for (EdgeIterator i = edges.first; i != edges.second; ++i)
+			{
+				::std::uint64_t u = this->graph[::boost::source(*i, this->graph)].index;
+				::std::uint64_t v = this->graph[::boost::target(*i, this->graph)].index;
+				::std::uint8_t verified = this->graph[*i].verified;
+				stream.write(reinterpret_cast<const char*>(&u), sizeof(u));
+				stream.write(reinterpret_cast<const char*>(&v), sizeof(v));
+				stream.write(reinterpret_cast<const char*>(&this->graph[*i].weight), sizeof(::rl::math::Real));
+				stream.write(reinterpret_cast<const char*>(&verified), sizeof(verified));
 			}
 			
+			if (!stream)
+			{
+				throw Exception("rl::plan::Prm::save() - Could not write file " + filename);
+			}
+		}
+		
+		bool
+		Prm::search()
+		{
 			if (this->astar)
 			{
 				::boost::astar_search(
@@ -261,6 +651,112 @@ namespace rl
 				);
 			}
 			
+			return this->graph[this->end].distance < ::std::numeric_limits<::rl::math::Real>::max();
+		}
+		
+		void
+		Prm::setNearestNeighbors(NearestNeighbors* nearestNeighbors)
+		{
+			this->graph[::boost::graph_bundle].nn = nearestNeighbors;
+		}
+		
+		bool
+		Prm::solve()
+		{
+			this->time = ::std::chrono::steady_clock::now();
+			
+			this->begin = this->addVertex(this->arena.makeShared<::rl::math::Vector>(*this->start));
+			this->insert(this->begin);
+			
+			this->end = this->addVertex(this->arena.makeShared<::rl::math::Vector>(*this->goal));
+			this->insert(this->end);
+			
+			while (true)
+			{
+				if (::boost::same_component(this->begin, this->end, this->ds))
+				{
+					if (!this->lazy)
+					{
+						this->search();
+						return true;
+					}
+					
+					// components only contain remaining edges, so search() succeeds
+					if (this->search() && this->verify())
+					{
+						return true;
+					}
+				}
+				
+				if (this->isExpired())
+				{
+					return false;
+				}
+				
+				if (!::boost::same_component(this->begin, this->end, this->ds))
+				{
+					this->construct(1);
+				}
+			}
+		}
+		
+		bool
+		Prm::verify()
+		{
+			::std::vector<Edge> edges;
+			::std::vector<::rl::math::Real> distances;
+			::std::vector<const ::rl::math::Vector*> first;
+			::std::vector<const ::rl::math::Vector*> second;
+			
+			for (Vertex v = this->end; v != this->begin; v = this->graph[v].predecessor)
+			{
+				Vertex u = this->graph[v].predecessor;
+				Edge e = ::boost::edge(u, v, this->graph).first;
+				
+				if (!this->graph[e].verified)
+				{
+					edges.push_back(e);
+					distances.push_back(this->graph[e].weight);
+					first.push_back(this->graph[u].q.get());
+					second.push_back(this->graph[v].q.get());
+				}
+			}
+			
+			::Eigen::Matrix<bool, ::Eigen::Dynamic, 1> colliding;
+			this->verifier->isColliding(first, second, distances, colliding);
+			
+			for (::std::size_t i = 0; i < edges.size(); ++i)
+			{
+				if (colliding(i))
+				{
+					::boost::remove_edge(edges[i], this->graph);
+				}
+				else
+				{
+					this->graph[edges[i]].verified = true;
+				}
+			}
+			
+			if (colliding.any())
+			{
+				// removed edges may have split components
+				VertexIteratorPair vertices = ::boost::vertices(this->graph);
+				
+				for (VertexIterator i = vertices.first; i != vertices.second; ++i)
+				{
+					this->ds.make_set(*i);
+				}
+				
+				EdgeIteratorPair remaining = ::boost::edges(this->graph);
+				
+				for (EdgeIterator i = remaining.first; i != remaining.second; ++i)
+				{
+					this->ds.union_set(::boost::source(*i, this->graph), ::boost::target(*i, this->graph));
+				}
+				
+				return false;
+			}
+			
 			return true;
 		}
 		
@@ -27,10 +27,13 @@
 #ifndef RL_PLAN_PRM_H
 #define RL_PLAN_PRM_H
 
+#include <cstdint>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/astar_search.hpp>
 #include <boost/pending/disjoint_sets.hpp>
+#include <rl/math/Matrix.h>
 
+#include "Arena.h"
 #include "Metric.h"
 #include "NearestNeighbors.h"
 #include "Planner.h"
@@ -70,6 +73,15 @@ namespace rl
 			
 			virtual void construct(const ::std::size_t& steps);
 			
+			/**
+			 * Hash of robot, scene and verifier resolution.
+			 *
+			 * Covers the position limits and kinematic parameters of the robot, the
+			 * names and transforms of all shapes, as well as the frames of all bodies
+			 * not belonging to the robot.
+			 */
+			::std::uint64_t getFingerprint() const;
+			
 			virtual ::std::string getName() const;
 			
 			NearestNeighbors* getNearestNeighbors() const;
@@ -80,20 +92,64 @@ namespace rl
 			
 			VectorList getPath();
 			
+			/**
+			 * Load roadmap from binary file.
+			 *
+			 * Replaces the current roadmap and rebuilds the nearest neighbors index.
+			 * Files with a different version, precision, number of degrees of
+			 * freedom, or fingerprint are rejected, as well as files whose size does
+			 * not match the number of vertices and edges.
+			 */
+			void load(const ::std::string& filename);
+			
 			void reset();
 			
+			/**
+			 * Save roadmap to binary file.
+			 *
+			 * The file consists of a fixed-size header followed by flat arrays of
+			 * vertex configurations, connected components, and weighted edges with
+			 * their verification status in native byte order.
+			 */
+			void save(const ::std::string& filename);
+			
 			void setNearestNeighbors(NearestNeighbors* nearestNeighbors);
 			
 			bool solve();
 			
 			bool astar;
 			
+			/**
+			 * Number of vertices added per round in construct().
+			 *
+			 * Rounds with more than one vertex sample configurations and verify
+			 * candidate edges together with Verifier::isColliding(), before merging
+			 * them into the roadmap.
+			 */
+			::std::size_t batch;
+			
 			/** Maximum degree per vertex. */
 			::std::size_t degree;
 			
 			/** Maximum number of tested neighbors. */
 			::std::size_t k;
 			
+			/**
+			 * Lazy PRM.
+			 *
+			 * Robert Bohlin and Lydia E. Kavraki. Path planning using lazy PRM. In
+			 * Proceedings of the IEEE International Conference on Robotics and
+			 * Automation, pages 521-528, San Francisco, CA, USA, April 2000.
+			 *
+			 * http://dx.doi.org/10.1109/ROBOT.2000.844107
+			 *
+			 * Edges are added to all neighbors without collision checks. solve()
+			 * only verifies edges on the shortest path, removes colliding ones and
+			 * searches again while start and goal remain connected, otherwise it
+			 * continues to construct the roadmap.
+			 */
+			bool lazy;
+			
 			/** Maximum radius for connecting neighbors. */
 			::rl::math::Real radius;
 			
@@ -104,13 +160,15 @@ namespace rl
 		protected:
 			struct EdgeBundle
 			{
+				bool verified;
+				
 				::rl::math::Real weight;
 			};
 			
 			struct GraphBundle;
 			
 			typedef ::boost::adjacency_list_traits<
-				::boost::listS,
+				::boost::vecS,
 				::boost::listS,
 				::boost::undirectedS,
 				::boost::listS
@@ -135,8 +193,15 @@ namespace rl
 				::std::size_t rank;
 			};
 			
+			/**
+			 * Roadmap with contiguous edge lists per vertex.
+			 *
+			 * Vertices stay in a list with stable descriptors, as nearest neighbors
+			 * refer to them and to their configurations by pointer. Configurations
+			 * are allocated from the arena of the planner.
+			 */
 			typedef ::boost::adjacency_list<
-				::boost::listS,
+				::boost::vecS,
 				::boost::listS,
 				::boost::undirectedS,
 				VertexBundle,
@@ -188,6 +253,30 @@ namespace rl
 			
 			void insert(const Vertex& vertex);
 			
+			void insert(const ::std::vector<Vertex>& vertices);
+			
+			/**
+			 * Find shortest path in roadmap.
+			 *
+			 * @return True if end is reachable from begin
+			 */
+			bool search();
+			
+			/**
+			 * Verify unchecked edges on path found by search().
+			 *
+			 * Colliding edges are removed from the roadmap and the connected
+			 * components are recalculated.
+			 *
+			 * @return True if all edges on the path are collision-free
+			 */
+			bool verify();
+			
+			/**
+			 * Storage of vertex configurations, released by reset().
+			 */
+			Arena arena;
+			
 			Vertex begin;
 			
 			::boost::disjoint_sets<VertexRankMap, VertexParentMap> ds;
@@ -197,7 +286,11 @@ namespace rl
 			Graph graph;
 			
 		private:
+			static void hash(const void* data, const ::std::size_t& size, ::std::uint64_t& value);
+			
+			static const char magic[8];
 			
+			static const ::std::uint32_t version;
 		};
 	}
 }
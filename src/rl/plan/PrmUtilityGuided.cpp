@@ -94,7 +94,7 @@ namespace rl
 				{
 					// store the sample in the graph
 					bestSample.isColliding = false;
-					Vertex v = this->addVertex(::std::make_shared<::rl::math::Vector>(bestSample.q));
+					Vertex v = this->addVertex(this->arena.makeShared<::rl::math::Vector>(bestSample.q));
 					this->insert(v);
 				}
 				
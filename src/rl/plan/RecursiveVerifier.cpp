@@ -42,12 +42,57 @@ namespace rl
 		{
 		}
 		
+		void
+		RecursiveVerifier::interpolate(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d, ::rl::math::Matrix& q)
+		{
+			assert(u.size() == this->model->getDofPosition());
+			assert(v.size() == this->model->getDofPosition());
+			
+			::std::size_t steps = this->getSteps(d);
+			
+			q.resize(u.size(), steps > 1 ? steps - 1 : 0);
+			
+			if (steps > 1)
+			{
+				::std::queue<::std::pair<::std::size_t, ::std::size_t>> queue;
+				
+				queue.emplace(::std::piecewise_construct, ::std::forward_as_tuple(1), ::std::forward_as_tuple(steps - 1));
+				
+				::rl::math::Vector inter(u.size());
+				
+				for (::std::ptrdiff_t i = 0; !queue.empty(); ++i)
+				{
+					::std::size_t midpoint = (queue.front().first + queue.front().second) / 2;
+					
+					this->model->interpolate(u, v, static_cast<::rl::math::Real>(midpoint) / static_cast<::rl::math::Real>(steps), inter);
+					q.col(i) = inter;
+					
+					if (queue.front().first < midpoint)
+					{
+						queue.emplace(::std::piecewise_construct, ::std::forward_as_tuple(queue.front().first), ::std::forward_as_tuple(midpoint - 1));
+					}
+					
+					if (queue.front().second > midpoint)
+					{
+						queue.emplace(::std::piecewise_construct, ::std::forward_as_tuple(midpoint + 1), ::std::forward_as_tuple(queue.front().second));
+					}
+					
+					queue.pop();
+				}
+			}
+		}
+		
 		bool
 		RecursiveVerifier::isColliding(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d)
 		{
 			assert(u.size() == this->model->getDofPosition());
 			assert(v.size() == this->model->getDofPosition());
 			
+			if (this->model->threads > 1)
+			{
+				return this->isCollidingInterpolated(u, v, d);
+			}
+			
 			::std::size_t steps = this->getSteps(d);
 			
 			if (steps > 1)
@@ -85,5 +130,11 @@ namespace rl
 			
 			return false;
 		}
+		
+		void
+		RecursiveVerifier::isColliding(const ::std::vector<const ::rl::math::Vector*>& u, const ::std::vector<const ::rl::math::Vector*>& v, const ::std::vector<::rl::math::Real>& d, ::Eigen::Matrix<bool, ::Eigen::Dynamic, 1>& result)
+		{
+			this->isCollidingInterpolated(u, v, d, result);
+		}
 	}
 }
@@ -38,6 +38,7 @@ namespace rl
 			delta(1),
 			epsilon(static_cast<::rl::math::Real>(1.0e-3)),
 			sampler(nullptr),
+			arena(),
 			begin(trees, nullptr),
 			end(trees, nullptr),
 			tree(trees)
@@ -64,7 +65,7 @@ namespace rl
 		Rrt::Vertex
 		Rrt::addVertex(Tree& tree, const VectorPtr& q)
 		{
-			::std::shared_ptr<VertexBundle> bundle = ::std::make_shared<VertexBundle>();
+			::std::shared_ptr<VertexBundle> bundle = this->arena.makeShared<VertexBundle>();
 			bundle->index = ::boost::num_vertices(tree) - 1;
 			bundle->q = q;
 			
@@ -117,7 +118,7 @@ namespace rl
 				step = this->delta;
 			}
 			
-			VectorPtr last = ::std::make_shared<::rl::math::Vector>(this->model->getDofPosition());
+			VectorPtr last = this->arena.makeShared<::rl::math::Vector>(this->model->getDofPosition());
 			
 			this->model->interpolate(*get(tree, nearest.second)->q, chosen, step / distance, *last);
 			
@@ -169,7 +170,7 @@ namespace rl
 			::rl::math::Real distance = nearest.first;
 			::rl::math::Real step = ::std::min(distance, this->delta);
 			
-			VectorPtr next = ::std::make_shared<::rl::math::Vector>(this->model->getDofPosition());
+			VectorPtr next = this->arena.makeShared<::rl::math::Vector>(this->model->getDofPosition());
 			
 			this->model->interpolate(*get(tree, nearest.second)->q, chosen, step / distance, *next);
 			
@@ -265,6 +266,10 @@ namespace rl
 				this->begin[i] = nullptr;
 				this->end[i] = nullptr;
 			}
+			
+			this->arena.clear();
+			
+			this->canceled = false;
 		}
 		
 		void
@@ -278,9 +283,9 @@ namespace rl
 		{
 			this->time = ::std::chrono::steady_clock::now();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->start));
+			this->begin[0] = this->addVertex(this->tree[0], this->arena.makeShared<::rl::math::Vector>(*this->start));
 			
-			while ((::std::chrono::steady_clock::now() - this->time) < this->duration)
+			while (!this->isExpired())
 			{
 				::rl::math::Vector chosen = this->choose();
 				Neighbor nearest = this->nearest(this->tree[0], chosen);
@@ -30,6 +30,7 @@
 #include <memory>
 #include <boost/graph/adjacency_list.hpp>
 
+#include "Arena.h"
 #include "Metric.h"
 #include "NearestNeighbors.h"
 #include "Planner.h"
@@ -92,8 +93,16 @@ namespace rl
 			
 			struct TreeBundle;
 			
+			/**
+			 * Tree with contiguous edge lists per vertex.
+			 *
+			 * Vertices stay in a list with stable descriptors, as nearest neighbors
+			 * and bundles of derived planners refer to them and to their
+			 * configurations by pointer. Bundles and configurations are allocated
+			 * from the arena of the planner.
+			 */
 			typedef ::boost::adjacency_list<
-				::boost::listS,
+				::boost::vecS,
 				::boost::listS,
 				::boost::bidirectionalS,
 				::std::shared_ptr<VertexBundle>,
@@ -102,7 +111,7 @@ namespace rl
 			> Tree;
 			
 			typedef ::boost::adjacency_list_traits<
-				::boost::listS,
+				::boost::vecS,
 				::boost::listS,
 				::boost::bidirectionalS,
 				::boost::listS
@@ -141,6 +150,11 @@ namespace rl
 			
 			virtual Neighbor nearest(const Tree& tree, const ::rl::math::Vector& chosen);
 			
+			/**
+			 * Storage of vertex bundles and configurations, released by reset().
+			 */
+			Arena arena;
+			
 			::std::vector<Vertex> begin;
 			
 			::std::vector<Vertex> end;
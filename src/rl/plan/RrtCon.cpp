@@ -51,9 +51,9 @@ namespace rl
 		{
 			this->time = ::std::chrono::steady_clock::now();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->start));
+			this->begin[0] = this->addVertex(this->tree[0], this->arena.makeShared<::rl::math::Vector>(*this->start));
 			
-			while ((::std::chrono::steady_clock::now() - this->time) < this->duration)
+			while (!this->isExpired())
 			{
 				::rl::math::Vector chosen = this->choose();
 				Neighbor nearest = this->nearest(this->tree[0], chosen);
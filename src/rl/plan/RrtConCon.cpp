@@ -51,13 +51,13 @@ namespace rl
 		{
 			this->time = ::std::chrono::steady_clock::now();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->start));
-			this->begin[1] = this->addVertex(this->tree[1], ::std::make_shared<::rl::math::Vector>(*this->goal));
+			this->begin[0] = this->addVertex(this->tree[0], this->arena.makeShared<::rl::math::Vector>(*this->start));
+			this->begin[1] = this->addVertex(this->tree[1], this->arena.makeShared<::rl::math::Vector>(*this->goal));
 			
 			Tree* a = &this->tree[0];
 			Tree* b = &this->tree[1];
 			
-			while ((::std::chrono::steady_clock::now() - this->time) < this->duration)
+			while (!this->isExpired())
 			{
 				for (::std::size_t j = 0; j < 2; ++j)
 				{
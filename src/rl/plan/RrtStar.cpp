@@ -0,0 +1,295 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <rl/math/TypeTraits.h>
+
+#include "RrtStar.h"
+#include "Sampler.h"
+#include "SimpleModel.h"
+#include "Verifier.h"
+#include "Viewer.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		RrtStar::RrtStar() :
+			RrtGoalBias(),
+			gamma(0),
+			informed(true),
+			verifier(nullptr),
+			goals()
+		{
+		}
+		
+		RrtStar::~RrtStar()
+		{
+		}
+		
+		RrtStar::Vertex
+		RrtStar::addVertex(Tree& tree, const VectorPtr& q)
+		{
+			::std::shared_ptr<VertexBundle> bundle = this->arena.makeShared<VertexBundle>();
+			bundle->cost = 0;
+			bundle->index = ::boost::num_vertices(tree) - 1;
+			bundle->q = q;
+			
+			Vertex v = ::boost::add_vertex(tree);
+			tree[v] = bundle;
+			
+			tree[::boost::graph_bundle].nn->push(Metric::Value(q.get(), v));
+			
+			if (nullptr != this->viewer)
+			{
+				this->viewer->drawConfigurationVertex(*get(tree, v)->q);
+			}
+			
+			return v;
+		}
+		
+		::rl::math::Real
+		RrtStar::calculateGamma() const
+		{
+			::rl::math::Real d = static_cast<::rl::math::Real>(this->model->getDofPosition());
+			::rl::math::Real volume = (this->model->getMaximum() - this->model->getMinimum()).prod();
+			::rl::math::Real ball = ::std::pow(::rl::math::TypeTraits<::rl::math::Real>::pi, d / 2) / ::std::tgamma(d / 2 + 1);
+			return 2 * ::std::pow((1 + 1 / d) * volume / ball, 1 / d);
+		}
+		
+		::rl::math::Vector
+		RrtStar::choose()
+		{
+			if (nullptr == this->end[0])
+			{
+				return RrtGoalBias::choose();
+			}
+			
+			::rl::math::Real cost = this->getCost();
+			
+			while (true)
+			{
+				::rl::math::Vector chosen = Rrt::choose();
+				
+				if (!this->informed || this->isExpired())
+				{
+					return chosen;
+				}
+				
+				// admissible heuristic of path length via chosen configuration
+				if (this->model->distance(*this->start, chosen) + this->model->distance(chosen, *this->goal) < cost)
+				{
+					return chosen;
+				}
+			}
+		}
+		
+		RrtStar::VertexBundle*
+		RrtStar::get(const Tree& tree, const Vertex& v)
+		{
+			return static_cast<VertexBundle*>(tree[v].get());
+		}
+		
+		::rl::math::Real
+		RrtStar::getCost() const
+		{
+			if (nullptr == this->end[0])
+			{
+				return ::std::numeric_limits<::rl::math::Real>::infinity();
+			}
+			
+			return get(this->tree[0], this->end[0])->cost;
+		}
+		
+		::std::string
+		RrtStar::getName() const
+		{
+			return "RRT*";
+		}
+		
+		::std::vector<RrtStar::Neighbor>
+		RrtStar::near(const Tree& tree, const ::rl::math::Vector& chosen, const ::rl::math::Real& radius)
+		{
+			NearestNeighbors* nn = tree[::boost::graph_bundle].nn;
+			::std::vector<NearestNeighbors::Neighbor> neighbors = nn->radius(
+				Metric::Value(&chosen, Vertex()),
+				nn->isTransformedDistance() ? this->model->transformedDistance(radius) : radius
+			);
+			
+			::std::vector<Neighbor> near;
+			near.reserve(neighbors.size());
+			
+			for (::std::size_t i = 0; i < neighbors.size(); ++i)
+			{
+				near.push_back(Neighbor(
+					nn->isTransformedDistance() ? this->model->inverseOfTransformedDistance(neighbors[i].first) : neighbors[i].first,
+					neighbors[i].second.second
+				));
+			}
+			
+			return near;
+		}
+		
+		void
+		RrtStar::reset()
+		{
+			Rrt::reset();
+			this->goals.clear();
+		}
+		
+		void
+		RrtStar::rewire(Tree& tree, const Vertex& u, const Vertex& v, const ::rl::math::Real& distance)
+		{
+			::boost::remove_edge(*::boost::in_edges(v, tree).first, tree);
+			this->addEdge(u, v, tree);
+			
+			::rl::math::Real delta = get(tree, u)->cost + distance - get(tree, v)->cost;
+			
+			::std::vector<Vertex> stack(1, v);
+			
+			while (!stack.empty())
+			{
+				Vertex w = stack.back();
+				stack.pop_back();
+				get(tree, w)->cost += delta;
+				
+				for (::std::pair<OutEdgeIterator, OutEdgeIterator> edges = ::boost::out_edges(w, tree); edges.first != edges.second; ++edges.first)
+				{
+					stack.push_back(::boost::target(*edges.first, tree));
+				}
+			}
+		}
+		
+		bool
+		RrtStar::solve()
+		{
+			this->time = ::std::chrono::steady_clock::now();
+			
+			this->begin[0] = this->addVertex(this->tree[0], this->arena.makeShared<::rl::math::Vector>(*this->start));
+			this->end[0] = nullptr;
+			this->goals.clear();
+			
+			::rl::math::Real d = static_cast<::rl::math::Real>(this->model->getDofPosition());
+			::rl::math::Real gamma = this->gamma > 0 ? this->gamma : this->calculateGamma();
+			
+			while (!this->isExpired())
+			{
+				::rl::math::Vector chosen = this->choose();
+				Neighbor nearest = this->nearest(this->tree[0], chosen);
+				
+				if (nearest.first <= 0)
+				{
+					continue;
+				}
+				
+				::rl::math::Real step = ::std::min(nearest.first, this->delta);
+				VectorPtr next = this->arena.makeShared<::rl::math::Vector>(this->model->getDofPosition());
+				this->model->interpolate(*get(this->tree[0], nearest.second)->q, chosen, step / nearest.first, *next);
+				
+				if (this->model->isColliding(*next))
+				{
+					continue;
+				}
+				
+				::rl::math::Real n = static_cast<::rl::math::Real>(::boost::num_vertices(this->tree[0]) + 1);
+				::rl::math::Real radius = ::std::min(gamma * ::std::pow(::std::log(n) / n, 1 / d), this->delta);
+				
+				::std::vector<Neighbor> neighbors = this->near(this->tree[0], *next, radius);
+				
+				if (neighbors.empty() || nearest.second != neighbors.front().second)
+				{
+					neighbors.insert(neighbors.begin(), Neighbor(step, nearest.second));
+				}
+				
+				// sort candidate parents once by cost and verify lazily
+				::std::vector<::std::pair<::rl::math::Real, ::std::size_t>> candidates(neighbors.size());
+				
+				for (::std::size_t i = 0; i < neighbors.size(); ++i)
+				{
+					candidates[i] = ::std::make_pair(get(this->tree[0], neighbors[i].second)->cost + neighbors[i].first, i);
+				}
+				
+				::std::sort(candidates.begin(), candidates.end());
+				
+				::std::size_t parent = neighbors.size();
+				
+				for (::std::size_t i = 0; i < candidates.size(); ++i)
+				{
+					const Neighbor& neighbor = neighbors[candidates[i].second];
+					
+					if (!this->verifier->isColliding(*get(this->tree[0], neighbor.second)->q, *next, neighbor.first))
+					{
+						parent = candidates[i].second;
+						break;
+					}
+				}
+				
+				if (neighbors.size() == parent)
+				{
+					continue;
+				}
+				
+				Vertex added = this->addVertex(this->tree[0], next);
+				this->addEdge(neighbors[parent].second, added, this->tree[0]);
+				get(this->tree[0], added)->cost = get(this->tree[0], neighbors[parent].second)->cost + neighbors[parent].first;
+				
+				for (::std::size_t i = 0; i < neighbors.size(); ++i)
+				{
+					if (parent == i || neighbors[i].second == neighbors[parent].second)
+					{
+						continue;
+					}
+					
+					if (get(this->tree[0], added)->cost + neighbors[i].first < get(this->tree[0], neighbors[i].second)->cost)
+					{
+						if (!this->verifier->isColliding(*next, *get(this->tree[0], neighbors[i].second)->q, neighbors[i].first))
+						{
+							this->rewire(this->tree[0], added, neighbors[i].second, neighbors[i].first);
+						}
+					}
+				}
+				
+				if (this->areEqual(*next, *this->goal))
+				{
+					this->goals.push_back(added);
+				}
+				
+				for (::std::size_t i = 0; i < this->goals.size(); ++i)
+				{
+					if (nullptr == this->end[0] || get(this->tree[0], this->goals[i])->cost < get(this->tree[0], this->end[0])->cost)
+					{
+						this->end[0] = this->goals[i];
+					}
+				}
+			}
+			
+			return nullptr != this->end[0];
+		}
+	}
+}
@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_RRTSTAR_H
+#define RL_PLAN_RRTSTAR_H
+
+#include "RrtGoalBias.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		class Verifier;
+		
+		/**
+		 * Optimal Rapidly-Exploring Random Trees.
+		 *
+		 * New vertices choose the parent with lowest cost within a shrinking
+		 * radius and neighbors are rewired through the new vertex if this lowers
+		 * their cost. Planning continues until duration expires and the best path
+		 * found so far is returned. Informed sampling rejects samples that cannot
+		 * improve the current solution.
+		 *
+		 * Sertac Karaman and Emilio Frazzoli. Sampling-based algorithms for optimal
+		 * motion planning. International Journal of Robotics Research,
+		 * 30(7):846-894, June 2011.
+		 *
+		 * http://dx.doi.org/10.1177/0278364911406761
+		 *
+		 * Jonathan D. Gammell, Siddhartha S. Srinivasa, and Timothy D. Barfoot.
+		 * Informed RRT*: Optimal sampling-based path planning focused via direct
+		 * sampling of an admissible ellipsoidal heuristic. In Proceedings of the
+		 * IEEE/RSJ International Conference on Intelligent Robots and Systems,
+		 * pages 2997-3004, September 2014.
+		 *
+		 * http://dx.doi.org/10.1109/IROS.2014.6942976
+		 */
+		class RL_PLAN_EXPORT RrtStar : public RrtGoalBias
+		{
+		public:
+			RrtStar();
+			
+			virtual ~RrtStar();
+			
+			/**
+			 * Length of best path found so far.
+			 *
+			 * @return Infinity if no path was found
+			 */
+			::rl::math::Real getCost() const;
+			
+			virtual ::std::string getName() const;
+			
+			virtual void reset();
+			
+			virtual bool solve();
+			
+			/**
+			 * Constant for rewiring radius.
+			 *
+			 * The radius \f$\gamma (\log n / n)^{1/d}\f$ is limited by delta. If zero,
+			 * the lower bound of Karaman and Frazzoli is calculated from the volume
+			 * within the joint limits.
+			 */
+			::rl::math::Real gamma;
+			
+			/** Reject samples that cannot improve the current path. */
+			bool informed;
+			
+			/** Verifier for edges between vertices. */
+			Verifier* verifier;
+			
+		protected:
+			typedef ::boost::graph_traits<Tree>::out_edge_iterator OutEdgeIterator;
+			
+			struct VertexBundle : Rrt::VertexBundle
+			{
+				/** Path length from start configuration. */
+				::rl::math::Real cost;
+			};
+			
+			Vertex addVertex(Tree& tree, const VectorPtr& q);
+			
+			virtual ::rl::math::Vector choose();
+			
+			static VertexBundle* get(const Tree& tree, const Vertex& v);
+			
+			/**
+			 * Vertices within radius of a configuration, sorted by distance.
+			 */
+			::std::vector<Neighbor> near(const Tree& tree, const ::rl::math::Vector& chosen, const ::rl::math::Real& radius);
+			
+			/**
+			 * Make u parent of v and update cost of v and its descendants.
+			 */
+			void rewire(Tree& tree, const Vertex& u, const Vertex& v, const ::rl::math::Real& distance);
+			
+		private:
+			::rl::math::Real calculateGamma() const;
+			
+			/** Vertices equal to the goal configuration. */
+			::std::vector<Vertex> goals;
+		};
+	}
+}
+
+#endif // RL_PLAN_RRTSTAR_H
@@ -53,5 +53,16 @@ namespace rl
 			
 			return q;
 		}
+		
+		void
+		Sampler::generateCollisionFree(const ::std::size_t& n, ::rl::math::Matrix& q)
+		{
+			q.resize(this->model->getDofPosition(), n);
+			
+			for (::std::size_t i = 0; i < n; ++i)
+			{
+				q.col(i) = this->generateCollisionFree();
+			}
+		}
 	}
 }
@@ -27,6 +27,7 @@
 #ifndef RL_PLAN_SAMPLER_H
 #define RL_PLAN_SAMPLER_H
 
+#include <rl/math/Matrix.h>
 #include <rl/math/Vector.h>
 #include <rl/plan/export.h>
 
@@ -47,6 +48,13 @@ namespace rl
 			
 			virtual ::rl::math::Vector generateCollisionFree();
 			
+			/**
+			 * Generate a block of collision-free configurations.
+			 *
+			 * @param[out] q Configurations, one per column
+			 */
+			virtual void generateCollisionFree(const ::std::size_t& n, ::rl::math::Matrix& q);
+			
 			SimpleModel* model;
 			
 		protected:
@@ -46,13 +46,18 @@ namespace rl
 			assert(u.size() == this->model->getDofPosition());
 			assert(v.size() == this->model->getDofPosition());
 			
-			::std::size_t steps = this->getSteps(d);;
+			if (this->model->threads > 1)
+			{
+				return this->isCollidingInterpolated(u, v, d);
+			}
+			
+			::std::size_t steps = this->getSteps(d);
 			
 			::rl::math::Vector inter(u.size());
 			
-			for (::std::size_t i = 0; i < steps - 1; ++i)
+			for (::std::size_t i = 1; i < steps; ++i)
 			{
-				this->model->interpolate(u, v, static_cast<::rl::math::Real>(i + 1) / static_cast<::rl::math::Real>(steps), inter);
+				this->model->interpolate(u, v, static_cast<::rl::math::Real>(i) / static_cast<::rl::math::Real>(steps), inter);
 				
 				if (this->model->isColliding(inter))
 				{
@@ -62,5 +67,11 @@ namespace rl
 			
 			return false;
 		}
+		
+		void
+		SequentialVerifier::isColliding(const ::std::vector<const ::rl::math::Vector*>& u, const ::std::vector<const ::rl::math::Vector*>& v, const ::std::vector<::rl::math::Real>& d, ::Eigen::Matrix<bool, ::Eigen::Dynamic, 1>& result)
+		{
+			this->isCollidingInterpolated(u, v, d, result);
+		}
 	}
 }
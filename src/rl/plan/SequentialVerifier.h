@@ -40,8 +40,12 @@ namespace rl
 			
 			virtual ~SequentialVerifier();
 			
+			using Verifier::isColliding;
+			
 			bool isColliding(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d);
 			
+			void isColliding(const ::std::vector<const ::rl::math::Vector*>& u, const ::std::vector<const ::rl::math::Vector*>& v, const ::std::vector<::rl::math::Real>& d, ::Eigen::Matrix<bool, ::Eigen::Dynamic, 1>& result);
+			
 		protected:
 			
 		private:
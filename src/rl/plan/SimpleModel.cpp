@@ -24,9 +24,16 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <atomic>
+#include <mutex>
+#include <rl/kin/Kinematics.h>
+#include <rl/mdl/Fixed.h>
+#include <rl/mdl/Kinematic.h>
 #include <rl/sg/Body.h>
 #include <rl/sg/SimpleScene.h>
 
+#include "CollisionCache.h"
+#include "CollisionContext.h"
 #include "SimpleModel.h"
 
 namespace rl
@@ -35,9 +42,14 @@ namespace rl
 	{
 		SimpleModel::SimpleModel() :
 			Model(),
+			cache(),
+			threads(1),
 			body(0),
 			freeQueries(0),
-			totalQueries(0)
+			totalQueries(0),
+			contexts(),
+			fingerprint(0),
+			pool()
 		{
 		}
 		
@@ -45,12 +57,83 @@ namespace rl
 		{
 		}
 		
+		::std::size_t
+		SimpleModel::getCacheHits() const
+		{
+			return nullptr != this->cache ? this->cache->getHits() : 0;
+		}
+		
+		::std::size_t
+		SimpleModel::getCacheMisses() const
+		{
+			return nullptr != this->cache ? this->cache->getMisses() : 0;
+		}
+		
 		::std::size_t
 		SimpleModel::getCollidingBody() const
 		{
 			return this->body;
 		}
 		
+		::std::size_t
+		SimpleModel::getFingerprint() const
+		{
+			::std::size_t seed = 0;
+			
+			auto combine = [&seed](const ::std::size_t& hash) {
+				seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			};
+			
+			auto combineFrame = [&combine](const ::rl::math::Transform& frame) {
+				for (::std::ptrdiff_t i = 0; i < 3; ++i)
+				{
+					for (::std::ptrdiff_t j = 0; j < 4; ++j)
+					{
+						combine(::std::hash<::rl::math::Real>()(frame(i, j)));
+					}
+				}
+			};
+			
+			combine(::std::hash<const void*>()(this->scene));
+			combine(::std::hash<const void*>()(this->model));
+			combine(this->model->getNumBodies());
+			
+			::rl::math::Transform frame;
+			
+			for (::rl::sg::Scene::Iterator i = this->scene->begin(); i != this->scene->end(); ++i)
+			{
+				if (this->model != *i)
+				{
+					combine((*i)->getNumBodies());
+					
+					for (::rl::sg::Model::Iterator j = (*i)->begin(); j != (*i)->end(); ++j)
+					{
+						(*j)->getFrame(frame);
+						combineFrame(frame);
+					}
+				}
+			}
+			
+			if (nullptr != this->kin)
+			{
+				combineFrame(static_cast<const ::rl::kin::Kinematics*>(this->kin)->world());
+			}
+			else if (nullptr != this->mdl)
+			{
+				combineFrame(static_cast<const ::rl::mdl::Model*>(this->mdl)->world());
+				
+				for (::std::size_t i = 0; i < this->mdl->getTransforms(); ++i)
+				{
+					if (::rl::mdl::Fixed* fixed = dynamic_cast<::rl::mdl::Fixed*>(this->mdl->getTransform(i)))
+					{
+						combineFrame(fixed->x.transform());
+					}
+				}
+			}
+			
+			return seed;
+		}
+		
 		::std::size_t
 		SimpleModel::getFreeQueries() const
 		{
@@ -111,15 +194,149 @@ namespace rl
 		{
 			this->setPosition(q);
 			this->updateFrames();
-			return this->isColliding();
+			return this->isCollidingCached(q);
+		}
+		
+		bool
+		SimpleModel::isColliding(const ::rl::math::Matrix& q, ::Eigen::Matrix<bool, ::Eigen::Dynamic, 1>& result, const bool& doStopEarly)
+		{
+			::std::size_t n = q.cols();
+			
+			result.setConstant(n, false);
+			
+			if (1 == n)
+			{
+				result(0) = this->isColliding(q.col(0));
+				return result(0);
+			}
+			
+			::std::size_t first = n;
+			::std::size_t body = this->getBodies();
+			::std::mutex mutex;
+			::std::atomic<::std::size_t> next(0);
+			::std::atomic<bool> stop(false);
+			
+			this->run([&](SimpleModel* model) {
+				for (::std::size_t i = next++; i < n && !stop; i = next++)
+				{
+					if (model->isColliding(q.col(i)))
+					{
+						result(i) = true;
+						
+						::std::lock_guard<::std::mutex> lock(mutex);
+						
+						if (i < first)
+						{
+							first = i;
+							body = model->getCollidingBody();
+						}
+						
+						if (doStopEarly)
+						{
+							stop = true;
+						}
+					}
+				}
+			});
+			
+			this->body = body;
+			return first < n;
+		}
+		
+		bool
+		SimpleModel::isCollidingCached(const ::rl::math::Vector& q)
+		{
+			if (nullptr == this->cache)
+			{
+				return this->isColliding();
+			}
+			
+			if (this->cache->find(q, this->body))
+			{
+				return this->body < this->getBodies();
+			}
+			
+			bool colliding = this->isColliding();
+			this->cache->insert(q, this->body);
+			return colliding;
+		}
+		
+		void
+		SimpleModel::invalidate()
+		{
+			if (nullptr != this->cache)
+			{
+				this->cache->clear();
+			}
+			
+			this->contexts.clear();
 		}
 		
 		void
 		SimpleModel::reset()
 		{
+			if (nullptr != this->cache)
+			{
+				this->cache->update(this->getFingerprint());
+				this->cache->resetCounters();
+			}
+			
+			this->contexts.clear();
 			this->body = 0;
 			this->freeQueries = 0;
 			this->totalQueries = 0;
 		}
+		
+		void
+		SimpleModel::run(const ::std::function<void(SimpleModel*)>& function)
+		{
+			::rl::sg::SimpleScene* scene = dynamic_cast<::rl::sg::SimpleScene*>(this->scene);
+			
+			if (this->threads < 2 || nullptr == this->mdl || nullptr == scene || !scene->isReentrant())
+			{
+				function(this);
+				return;
+			}
+			
+			if (nullptr == this->pool || this->pool->size() != this->threads)
+			{
+				this->pool.reset(new ::rl::util::thread_pool(this->threads));
+			}
+			
+			::std::size_t fingerprint = this->getFingerprint();
+			
+			if (fingerprint != this->fingerprint)
+			{
+				this->contexts.clear();
+				this->fingerprint = fingerprint;
+			}
+			
+			if (nullptr != this->cache)
+			{
+				this->cache->update(fingerprint);
+			}
+			
+			while (this->contexts.size() < this->pool->size())
+			{
+				this->contexts.emplace_back(new CollisionContext(this));
+			}
+			
+			for (::std::size_t i = 0; i < this->contexts.size(); ++i)
+			{
+				this->contexts[i]->cache = this->cache;
+			}
+			
+			this->pool->run([&](const ::std::size_t& worker) {
+				function(this->contexts[worker].get());
+			});
+			
+			for (::std::size_t i = 0; i < this->pool->size(); ++i)
+			{
+				this->freeQueries += this->contexts[i]->getFreeQueries();
+				this->totalQueries += this->contexts[i]->getTotalQueries();
+				this->contexts[i]->cache.reset();
+				this->contexts[i]->reset();
+			}
+		}
 	}
 }
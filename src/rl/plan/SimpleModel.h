@@ -27,12 +27,21 @@
 #ifndef RL_PLAN_SIMPLEMODEL_H
 #define RL_PLAN_SIMPLEMODEL_H
 
+#include <functional>
+#include <memory>
+#include <vector>
+#include <rl/math/Matrix.h>
+#include <rl/util/thread_pool.h>
+
 #include "Model.h"
 
 namespace rl
 {
 	namespace plan
 	{
+		class CollisionCache;
+		class CollisionContext;
+		
 		class RL_PLAN_EXPORT SimpleModel : public Model
 		{
 		public:
@@ -40,6 +49,12 @@ namespace rl
 			
 			virtual ~SimpleModel();
 			
+			/** Number of queries answered by cache. */
+			::std::size_t getCacheHits() const;
+			
+			/** Number of queries not found in cache. */
+			::std::size_t getCacheMisses() const;
+			
 			::std::size_t getCollidingBody() const;
 			
 			::std::size_t getFreeQueries() const;
@@ -52,9 +67,70 @@ namespace rl
 			
 			virtual bool isColliding(const ::rl::math::Vector& q);
 			
+			/**
+			 * Check a block of configurations for collisions.
+			 *
+			 * Columns are distributed over the threads of run().
+			 *
+			 * @param[in] q Configurations, one per column
+			 * @param[out] result Collision status per column, unchecked columns
+			 * are false
+			 * @param[in] doStopEarly Stop after the first collision is found
+			 * @return True if any configuration is colliding
+			 */
+			virtual bool isColliding(const ::rl::math::Matrix& q, ::Eigen::Matrix<bool, ::Eigen::Dynamic, 1>& result, const bool& doStopEarly = false);
+			
+			/**
+			 * Discard cached collision results and the contexts of run().
+			 *
+			 * Call this after moving other bodies of the scene or modifying the
+			 * world or fixed transforms of the kinematic model between calls of
+			 * reset().
+			 */
+			void invalidate();
+			
 			virtual void reset();
 			
+			/**
+			 * Call function on a pool of threads, each with its own model.
+			 *
+			 * Every worker uses a separate CollisionContext sharing the scene of this
+			 * model. Contexts are recreated whenever getFingerprint() changed since
+			 * the last call. With a single thread, models without
+			 * rl::mdl::Kinematic or scenes that are not reentrant, function is
+			 * called only once with this model.
+			 */
+			void run(const ::std::function<void(SimpleModel*)>& function);
+			
+			/**
+			 * Optional cache of collision results, shared with the contexts of run().
+			 *
+			 * Results of cache hits are not counted in getTotalQueries(). The cache
+			 * is cleared if getFingerprint() changed at reset() or run(), and by
+			 * invalidate().
+			 */
+			::std::shared_ptr<CollisionCache> cache;
+			
+			/** Number of threads for checking blocks of configurations, defaults to 1. */
+			::std::size_t threads;
+			
 		protected:
+			/**
+			 * Hash of the scene and robot that collision results depend on.
+			 *
+			 * Covers the scene and robot model, the frames of all other bodies, and
+			 * the world and fixed transforms of the kinematic model, but not the
+			 * joint positions.
+			 */
+			::std::size_t getFingerprint() const;
+			
+			/**
+			 * Check configuration q after its frames were updated, using the cache.
+			 *
+			 * Callers need to call setPosition() and updateFrames() before.
+			 */
+			bool isCollidingCached(const ::rl::math::Vector& q);
+			
 			::std::size_t body;
 			
 			::std::size_t freeQueries;
@@ -62,7 +138,11 @@ namespace rl
 			::std::size_t totalQueries;
 			
 		private:
+			::std::vector<::std::unique_ptr<CollisionContext>> contexts;
+			
+			::std::size_t fingerprint;
 			
+			::std::unique_ptr<::rl::util::thread_pool> pool;
 		};
 	}
 }
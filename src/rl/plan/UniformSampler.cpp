@@ -25,6 +25,7 @@
 //
 
 #include <chrono>
+#include <typeinfo>
 
 #include "SimpleModel.h"
 #include "UniformSampler.h"
@@ -57,6 +58,42 @@ namespace rl
 			return this->model->generatePositionUniform(rand);
 		}
 		
+		void
+		UniformSampler::generateCollisionFree(const ::std::size_t& n, ::rl::math::Matrix& q)
+		{
+			// derived samplers reject differently than uniform samples
+			if (typeid(*this) != typeid(UniformSampler))
+			{
+				Sampler::generateCollisionFree(n, q);
+				return;
+			}
+			
+			q.resize(this->model->getDofPosition(), n);
+			
+			::rl::math::Matrix samples(this->model->getDofPosition(), n);
+			::Eigen::Matrix<bool, ::Eigen::Dynamic, 1> result;
+			
+			for (::std::size_t i = 0; i < n;)
+			{
+				samples.conservativeResize(::Eigen::NoChange, n - i);
+				
+				for (::std::ptrdiff_t j = 0; j < samples.cols(); ++j)
+				{
+					samples.col(j) = this->generate();
+				}
+				
+				this->model->isColliding(samples, result);
+				
+				for (::std::ptrdiff_t j = 0; j < samples.cols(); ++j)
+				{
+					if (!result(j))
+					{
+						q.col(i++) = samples.col(j);
+					}
+				}
+			}
+		}
+		
 		::std::uniform_real_distribution<::rl::math::Real>::result_type
 		UniformSampler::rand()
 		{
@@ -47,6 +47,18 @@ namespace rl
 			
 			::rl::math::Vector generate();
 			
+			using Sampler::generateCollisionFree;
+			
+			/**
+			 * Generate a block of collision-free configurations.
+			 *
+			 * Checks uniform samples in batches. Derived samplers use
+			 * Sampler::generateCollisionFree() on their own samples.
+			 *
+			 * @param[out] q Configurations, one per column
+			 */
+			virtual void generateCollisionFree(const ::std::size_t& n, ::rl::math::Matrix& q);
+			
 			virtual void seed(const ::std::mt19937::result_type& value);
 			
 		protected:
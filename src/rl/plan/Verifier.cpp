@@ -24,6 +24,9 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <atomic>
+
+#include "SimpleModel.h"
 #include "Verifier.h"
 
 namespace rl
@@ -45,5 +48,79 @@ namespace rl
 		{
 			return static_cast<::std::size_t>(::std::ceil(d / this->delta));
 		}
+		
+		void
+		Verifier::interpolate(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d, ::rl::math::Matrix& q)
+		{
+			assert(u.size() == this->model->getDofPosition());
+			assert(v.size() == this->model->getDofPosition());
+			
+			::std::size_t steps = this->getSteps(d);
+			
+			q.resize(u.size(), steps > 1 ? steps - 1 : 0);
+			
+			::rl::math::Vector inter(u.size());
+			
+			for (::std::ptrdiff_t i = 0; i < q.cols(); ++i)
+			{
+				this->model->interpolate(u, v, static_cast<::rl::math::Real>(i + 1) / static_cast<::rl::math::Real>(steps), inter);
+				q.col(i) = inter;
+			}
+		}
+		
+		void
+		Verifier::isColliding(const ::std::vector<const ::rl::math::Vector*>& u, const ::std::vector<const ::rl::math::Vector*>& v, const ::std::vector<::rl::math::Real>& d, ::Eigen::Matrix<bool, ::Eigen::Dynamic, 1>& result)
+		{
+			result.resize(d.size());
+			
+			for (::std::size_t i = 0; i < d.size(); ++i)
+			{
+				result(i) = this->isColliding(*u[i], *v[i], d[i]);
+			}
+		}
+		
+		bool
+		Verifier::isCollidingInterpolated(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d)
+		{
+			::rl::math::Matrix q;
+			this->interpolate(u, v, d, q);
+			::Eigen::Matrix<bool, ::Eigen::Dynamic, 1> result;
+			return this->model->isColliding(q, result, true);
+		}
+		
+		void
+		Verifier::isCollidingInterpolated(const ::std::vector<const ::rl::math::Vector*>& u, const ::std::vector<const ::rl::math::Vector*>& v, const ::std::vector<::rl::math::Real>& d, ::Eigen::Matrix<bool, ::Eigen::Dynamic, 1>& result)
+		{
+			if (this->model->threads < 2)
+			{
+				Verifier::isColliding(u, v, d, result);
+				return;
+			}
+			
+			::std::vector<::rl::math::Matrix> q(d.size());
+			
+			for (::std::size_t i = 0; i < d.size(); ++i)
+			{
+				this->interpolate(*u[i], *v[i], d[i], q[i]);
+			}
+			
+			result.setConstant(d.size(), false);
+			
+			::std::atomic<::std::size_t> next(0);
+			
+			this->model->run([&](SimpleModel* model) {
+				for (::std::size_t i = next++; i < q.size(); i = next++)
+				{
+					for (::std::ptrdiff_t j = 0; j < q[i].cols(); ++j)
+					{
+						if (model->isColliding(q[i].col(j)))
+						{
+							result(i) = true;
+							break;
+						}
+					}
+				}
+			});
+		}
 	}
 }
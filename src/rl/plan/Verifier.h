@@ -27,6 +27,8 @@
 #ifndef RL_PLAN_VERIFIER_H
 #define RL_PLAN_VERIFIER_H
 
+#include <vector>
+#include <rl/math/Matrix.h>
 #include <rl/math/Vector.h>
 #include <rl/plan/export.h>
 
@@ -45,13 +47,49 @@ namespace rl
 			
 			virtual ::std::size_t getSteps(const ::rl::math::Real& d);
 			
+			/**
+			 * Intermediate configurations of an edge in the order they are checked.
+			 *
+			 * @param[out] q Configurations, one per column
+			 */
+			virtual void interpolate(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d, ::rl::math::Matrix& q);
+			
 			virtual bool isColliding(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d) = 0;
 			
+			/**
+			 * Check several edges for collisions.
+			 *
+			 * The default implementation calls isColliding(u, v, d) for every edge.
+			 *
+			 * @param[in] u First configurations, one per edge
+			 * @param[in] v Second configurations, one per edge
+			 * @param[in] d Distances, one per edge
+			 * @param[out] result Collision status per edge
+			 */
+			virtual void isColliding(const ::std::vector<const ::rl::math::Vector*>& u, const ::std::vector<const ::rl::math::Vector*>& v, const ::std::vector<::rl::math::Real>& d, ::Eigen::Matrix<bool, ::Eigen::Dynamic, 1>& result);
+			
 			::rl::math::Real delta;
 			
 			SimpleModel* model;
 			
 		protected:
+			/**
+			 * Check the configurations of interpolate() of an edge as one block.
+			 *
+			 * Configurations are distributed over the threads of SimpleModel::run(),
+			 * which only pays off with SimpleModel::threads greater than one, as all
+			 * of them are interpolated before the first check.
+			 */
+			bool isCollidingInterpolated(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d);
+			
+			/**
+			 * Check the configurations of interpolate() for several edges.
+			 *
+			 * Edges are distributed over the threads of SimpleModel::run(). Only
+			 * equivalent to isColliding(u, v, d) for verifiers that check exactly
+			 * the configurations of interpolate().
+			 */
+			void isCollidingInterpolated(const ::std::vector<const ::rl::math::Vector*>& u, const ::std::vector<const ::rl::math::Vector*>& v, const ::std::vector<::rl::math::Real>& d, ::Eigen::Matrix<bool, ::Eigen::Dynamic, 1>& result);
 			
 		private:
 			
@@ -58,6 +58,25 @@ namespace rl
 			return false;
 		}
 		
+		bool
+		SimpleScene::areColliding(Body* first, const ::rl::math::Transform& frame1, Body* second, const ::rl::math::Transform& frame2)
+		{
+			::rl::math::Transform previous1;
+			first->getFrame(previous1);
+			::rl::math::Transform previous2;
+			second->getFrame(previous2);
+			
+			first->setFrame(frame1);
+			second->setFrame(frame2);
+			
+			bool colliding = this->areColliding(first, second);
+			
+			first->setFrame(previous1);
+			second->setFrame(previous2);
+			
+			return colliding;
+		}
+		
 		bool
 		SimpleScene::areColliding(Model* first, Model* second)
 		{
@@ -91,5 +110,11 @@ namespace rl
 			
 			return false;
 		}
+		
+		bool
+		SimpleScene::isReentrant() const
+		{
+			return false;
+		}
 	}
 }
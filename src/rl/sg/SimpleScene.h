@@ -27,6 +27,8 @@
 #ifndef RL_SG_SIMPLESCENE_H
 #define RL_SG_SIMPLESCENE_H
 
+#include <rl/math/Transform.h>
+
 #include "Scene.h"
 
 namespace rl
@@ -46,12 +48,24 @@ namespace rl
 			
 			virtual bool areColliding(Body* first, Body* second);
 			
+			/**
+			 * Check two bodies at the given world frames for collision.
+			 *
+			 * The default implementation temporarily moves both bodies to the
+			 * given frames. Scenes returning true in isReentrant() leave the
+			 * bodies untouched, so that this can be called concurrently from
+			 * several threads.
+			 */
+			virtual bool areColliding(Body* first, const ::rl::math::Transform& frame1, Body* second, const ::rl::math::Transform& frame2);
+			
 			virtual bool areColliding(Model* first, Model* second);
 			
 			virtual bool areColliding(Shape* first, Shape* second) = 0;
 			
 			virtual bool isColliding();
 			
+			virtual bool isReentrant() const;
+			
 		protected:
 			
 		private:
@@ -0,0 +1,74 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <limits>
+
+#include "Body.h"
+#include "SweepScene.h"
+
+namespace rl
+{
+	namespace sg
+	{
+		SweepScene::SweepScene() :
+			Scene()
+		{
+		}
+		
+		SweepScene::~SweepScene()
+		{
+		}
+		
+		bool
+		SweepScene::sweep(Body* first, const ::rl::math::Transform& start1, const ::rl::math::Transform& goal1, Body* second, const ::rl::math::Transform& start2, const ::rl::math::Transform& goal2, ::rl::math::Real& time)
+		{
+			bool colliding = false;
+			
+			for (Body::Iterator i = first->begin(); i != first->end(); ++i)
+			{
+				for (Body::Iterator j = second->begin(); j != second->end(); ++j)
+				{
+					::rl::math::Real contact;
+					
+					if (this->sweep(*i, start1, goal1, *j, start2, goal2, contact))
+					{
+						time = colliding ? ::std::min(time, contact) : contact;
+						colliding = true;
+						
+						// no earlier contact possible
+						if (time <= ::std::numeric_limits<::rl::math::Real>::epsilon())
+						{
+							return true;
+						}
+					}
+				}
+			}
+			
+			return colliding;
+		}
+	}
+}
@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_SG_SWEEPSCENE_H
+#define RL_SG_SWEEPSCENE_H
+
+#include <rl/math/Transform.h>
+
+#include "Scene.h"
+
+namespace rl
+{
+	namespace sg
+	{
+		class Body;
+		class Shape;
+		
+		/**
+		 * Continuous collision checking of moving bodies.
+		 *
+		 * Each body moves from a start to a goal frame, the motion in between is
+		 * interpolated by the backend, e.g., as screw motion. Implementations do
+		 * not modify the frames of the bodies and may be called concurrently.
+		 */
+		class RL_SG_EXPORT SweepScene : public virtual Scene
+		{
+		public:
+			SweepScene();
+			
+			virtual ~SweepScene();
+			
+			/**
+			 * Check two bodies for collision during motion.
+			 *
+			 * Stops at the first pair of shapes in contact at the start of motion.
+			 *
+			 * @param[out] time Fraction of motion at first contact if colliding
+			 * @return True if bodies collide during motion
+			 */
+			virtual bool sweep(Body* first, const ::rl::math::Transform& start1, const ::rl::math::Transform& goal1, Body* second, const ::rl::math::Transform& start2, const ::rl::math::Transform& goal2, ::rl::math::Real& time);
+			
+			/**
+			 * Check two shapes for collision during motion of their bodies.
+			 *
+			 * Frames are given for the bodies of the shapes.
+			 *
+			 * @param[out] time Fraction of motion at first contact if colliding
+			 * @return True if shapes collide during motion
+			 */
+			virtual bool sweep(Shape* first, const ::rl::math::Transform& start1, const ::rl::math::Transform& goal1, Shape* second, const ::rl::math::Transform& start2, const ::rl::math::Transform& goal2, ::rl::math::Real& time) = 0;
+			
+		protected:
+			
+		private:
+			
+		};
+	}
+}
+
+#endif // RL_SG_SWEEPSCENE_H
@@ -24,6 +24,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <BulletCollision/NarrowPhaseCollision/btContinuousConvexCollision.h>
 #include <BulletCollision/NarrowPhaseCollision/btConvexPenetrationDepthSolver.h>
 #include <BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h>
 #include <BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h>
@@ -47,6 +48,7 @@ namespace rl
 				::rl::sg::DistanceScene(),
 				::rl::sg::RaycastScene(),
 				::rl::sg::SimpleScene(),
+				::rl::sg::SweepScene(),
 				broadphase(),
 				configuration(),
 				dispatcher(&configuration),
@@ -80,6 +82,23 @@ namespace rl
 				throw Exception("::rl::sg::bullet::Scene::areColliding(::rl::sg::Shape* first, ::rl::sg::Shape* second) - not supported");
 			}
 			
+			::btTransform
+			Scene::convert(const ::rl::math::Transform& frame)
+			{
+				return ::btTransform(
+					::btMatrix3x3(
+						static_cast<::btScalar>(frame(0, 0)), static_cast<::btScalar>(frame(0, 1)), static_cast<::btScalar>(frame(0, 2)),
+						static_cast<::btScalar>(frame(1, 0)), static_cast<::btScalar>(frame(1, 1)), static_cast<::btScalar>(frame(1, 2)),
+						static_cast<::btScalar>(frame(2, 0)), static_cast<::btScalar>(frame(2, 1)), static_cast<::btScalar>(frame(2, 2))
+					),
+					::btVector3(
+						static_cast<::btScalar>(frame(0, 3)),
+						static_cast<::btScalar>(frame(1, 3)),
+						static_cast<::btScalar>(frame(2, 3))
+					)
+				);
+			}
+			
 			::rl::sg::Model*
 			Scene::create()
 			{
@@ -301,6 +320,45 @@ namespace rl
 				}
 			}
 			
+			bool
+			Scene::sweep(::rl::sg::Shape* first, const ::rl::math::Transform& start1, const ::rl::math::Transform& goal1, ::rl::sg::Shape* second, const ::rl::math::Transform& start2, const ::rl::math::Transform& goal2, ::rl::math::Real& time)
+			{
+				Shape* shape1 = static_cast<Shape*>(first);
+				Shape* shape2 = static_cast<Shape*>(second);
+				
+				if (!shape1->shape->isConvex() || !shape2->shape->isConvex())
+				{
+					throw Exception("::rl::sg::bullet::Scene::sweep() - continuous collision detection only supported between convex shapes");
+				}
+				
+				::btVoronoiSimplexSolver simplexSolver;
+				::btGjkEpaPenetrationDepthSolver penetrationDepthSolver;
+				::btContinuousConvexCollision convexCollision(
+					static_cast<::btConvexShape*>(shape1->shape.get()),
+					static_cast<::btConvexShape*>(shape2->shape.get()),
+					&simplexSolver,
+					&penetrationDepthSolver
+				);
+				
+				::btConvexCast::CastResult result;
+				
+				if (convexCollision.calcTimeOfImpact(
+					Scene::convert(start1) * shape1->transform,
+					Scene::convert(goal1) * shape1->transform,
+					Scene::convert(start2) * shape2->transform,
+					Scene::convert(goal2) * shape2->transform,
+					result
+				))
+				{
+					time = result.m_fraction;
+					return true;
+				}
+				else
+				{
+					return false;
+				}
+			}
+			
 			Scene::ContactResultCallback::ContactResultCallback() :
 				collision(false),
 				distance(0),
@@ -33,6 +33,7 @@
 #include "../DistanceScene.h"
 #include "../RaycastScene.h"
 #include "../SimpleScene.h"
+#include "../SweepScene.h"
 
 namespace rl
 {
@@ -45,7 +46,7 @@ namespace rl
 		 */
 		namespace bullet
 		{
-			class RL_SG_EXPORT Scene : public ::rl::sg::DepthScene, public ::rl::sg::DistanceScene, public ::rl::sg::RaycastScene, public ::rl::sg::SimpleScene
+			class RL_SG_EXPORT Scene : public ::rl::sg::DepthScene, public ::rl::sg::DistanceScene, public ::rl::sg::RaycastScene, public ::rl::sg::SimpleScene, public ::rl::sg::SweepScene
 			{
 			public:
 				Scene();
@@ -80,6 +81,10 @@ namespace rl
 				
 				bool raycast(::rl::sg::Shape* shape, const ::rl::math::Vector3& source, const ::rl::math::Vector3& target, ::rl::math::Real& distance);
 				
+				using ::rl::sg::SweepScene::sweep;
+				
+				bool sweep(::rl::sg::Shape* first, const ::rl::math::Transform& start1, const ::rl::math::Transform& goal1, ::rl::sg::Shape* second, const ::rl::math::Transform& start2, const ::rl::math::Transform& goal2, ::rl::math::Real& time);
+				
 				::btDbvtBroadphase broadphase;
 				
 				::btDefaultCollisionConfiguration configuration;
@@ -91,6 +96,8 @@ namespace rl
 			protected:
 				
 			private:
+				static ::btTransform convert(const ::rl::math::Transform& frame);
+				
 				struct ContactResultCallback : public ::btCollisionWorld::ContactResultCallback
 				{
 					ContactResultCallback();
@@ -65,6 +65,7 @@ namespace rl
 			Scene::Scene() :
 				::rl::sg::Scene(),
 				::rl::sg::SimpleScene(),
+				::rl::sg::SweepScene(),
 				manager(),
 				bodyForObj()
 			{
@@ -113,6 +114,32 @@ namespace rl
 				return collisionData.result.isCollision();
 			}
 			
+			bool
+			Scene::areColliding(::rl::sg::Body* first, const ::rl::math::Transform& frame1, ::rl::sg::Body* second, const ::rl::math::Transform& frame2)
+			{
+				for (::rl::sg::Body::Iterator i = first->begin(); i != first->end(); ++i)
+				{
+					Shape* shape1 = static_cast<Shape*>(*i);
+					Transform3 transform1 = shape1->getCollisionTransform(frame1);
+					
+					for (::rl::sg::Body::Iterator j = second->begin(); j != second->end(); ++j)
+					{
+						Shape* shape2 = static_cast<Shape*>(*j);
+						
+						CollisionRequest request;
+						CollisionResult result;
+						::fcl::collide(shape1->getCollisionGeometry(), transform1, shape2->getCollisionGeometry(), shape2->getCollisionTransform(frame2), request, result);
+						
+						if (result.isCollision())
+						{
+							return true;
+						}
+					}
+				}
+				
+				return false;
+			}
+			
 			bool
 			Scene::areColliding(::rl::sg::Model* first, ::rl::sg::Model* second)
 			{
@@ -371,6 +398,12 @@ namespace rl
 				return collisionData.result.isCollision();
 			}
 			
+			bool
+			Scene::isReentrant() const
+			{
+				return true;
+			}
+			
 			bool
 			Scene::isScalingSupported() const
 			{
@@ -402,6 +435,23 @@ namespace rl
 				this->manager.unregisterObject(collisionObject);
 			}
 			
+			bool
+			Scene::sweep(::rl::sg::Shape* first, const ::rl::math::Transform& start1, const ::rl::math::Transform& goal1, ::rl::sg::Shape* second, const ::rl::math::Transform& start2, const ::rl::math::Transform& goal2, ::rl::math::Real& time)
+			{
+				Shape* shape1 = static_cast<Shape*>(first);
+				Shape* shape2 = static_cast<Shape*>(second);
+				
+				ContinuousCollisionRequest request;
+				request.ccd_motion_type = ::fcl::CCDM_SCREW;
+				request.ccd_solver_type = ::fcl::CCDC_CONSERVATIVE_ADVANCEMENT;
+				ContinuousCollisionResult result;
+				::fcl::continuousCollide(shape1->getCollisionGeometry(), shape1->getCollisionTransform(start1), shape1->getCollisionTransform(goal1), shape2->getCollisionGeometry(), shape2->getCollisionTransform(start2), shape2->getCollisionTransform(goal2), request, result);
+				
+				time = result.time_of_contact;
+				
+				return result.is_collide;
+			}
+			
 			Scene::CollisionData::CollisionData(const ::std::unordered_map<CollisionObject*, Body*>& bodyForObj) :
 				bodyForObj(bodyForObj),
 				done(false),
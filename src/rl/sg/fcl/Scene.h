@@ -32,15 +32,18 @@
 
 #if FCL_MAJOR_VERSION < 1 && FCL_MINOR_VERSION < 6
 #include <fcl/collision.h>
+#include <fcl/continuous_collision.h>
 #include <fcl/broadphase/broadphase.h>
 #else
 #include <fcl/broadphase/broadphase_dynamic_AABB_tree.h>
 #include <fcl/narrowphase/collision.h>
+#include <fcl/narrowphase/continuous_collision.h>
 #endif
 
 #include "../DepthScene.h"
 #include "../DistanceScene.h"
 #include "../SimpleScene.h"
+#include "../SweepScene.h"
 
 namespace rl
 {
@@ -57,6 +60,8 @@ namespace rl
 			typedef ::fcl::CollisionObject CollisionObject;
 			typedef ::fcl::CollisionRequest CollisionRequest;
 			typedef ::fcl::CollisionResult CollisionResult;
+			typedef ::fcl::ContinuousCollisionRequest ContinuousCollisionRequest;
+			typedef ::fcl::ContinuousCollisionResult ContinuousCollisionResult;
 			typedef ::fcl::DistanceRequest DistanceRequest;
 			typedef ::fcl::DistanceResult DistanceResult;
 			typedef ::fcl::DynamicAABBTreeCollisionManager DynamicAABBTreeCollisionManager;
@@ -65,13 +70,15 @@ namespace rl
 			typedef ::fcl::CollisionObject<::rl::math::Real> CollisionObject;
 			typedef ::fcl::CollisionRequest<::rl::math::Real> CollisionRequest;
 			typedef ::fcl::CollisionResult<::rl::math::Real> CollisionResult;
+			typedef ::fcl::ContinuousCollisionRequest<::rl::math::Real> ContinuousCollisionRequest;
+			typedef ::fcl::ContinuousCollisionResult<::rl::math::Real> ContinuousCollisionResult;
 			typedef ::fcl::DistanceRequest<::rl::math::Real> DistanceRequest;
 			typedef ::fcl::DistanceResult<::rl::math::Real> DistanceResult;
 			typedef ::fcl::DynamicAABBTreeCollisionManager<::rl::math::Real> DynamicAABBTreeCollisionManager;
 			typedef ::rl::math::Real Real;
 #endif
 			
-			class RL_SG_EXPORT Scene : public ::rl::sg::DepthScene, public ::rl::sg::DistanceScene, public ::rl::sg::SimpleScene
+			class RL_SG_EXPORT Scene : public ::rl::sg::DepthScene, public ::rl::sg::DistanceScene, public ::rl::sg::SimpleScene, public ::rl::sg::SweepScene
 			{
 			public:
 				Scene();
@@ -84,6 +91,8 @@ namespace rl
 				
 				bool areColliding(::rl::sg::Body* first, ::rl::sg::Body* second);
 				
+				bool areColliding(::rl::sg::Body* first, const ::rl::math::Transform& frame1, ::rl::sg::Body* second, const ::rl::math::Transform& frame2);
+				
 				bool areColliding(::rl::sg::Model* first, ::rl::sg::Model* second);
 				
 				bool areColliding(::rl::sg::Shape* first, ::rl::sg::Shape* second);
@@ -104,12 +113,18 @@ namespace rl
 				
 				bool isColliding();
 				
+				bool isReentrant() const;
+				
 				bool isScalingSupported() const;
 				
 				void remove(::rl::sg::Model* model);
 				
 				void removeCollisionObject(CollisionObject* collisionObject);
 				
+				using ::rl::sg::SweepScene::sweep;
+				
+				bool sweep(::rl::sg::Shape* first, const ::rl::math::Transform& start1, const ::rl::math::Transform& goal1, ::rl::sg::Shape* second, const ::rl::math::Transform& start2, const ::rl::math::Transform& goal2, ::rl::math::Real& time);
+				
 				DynamicAABBTreeCollisionManager manager;
 				
 			protected:
@@ -271,12 +271,44 @@ namespace rl
 				static_cast<Body*>(this->getBody())->remove(this);
 			}
 			
+			CollisionGeometry*
+			Shape::getCollisionGeometry() const
+			{
+				return this->geometry.get();
+			}
+			
 			CollisionObject*
 			Shape::getCollisionObject() const
 			{
 				return this->object.get();
 			}
 			
+			Transform3
+			Shape::getCollisionTransform(const ::rl::math::Transform& frame) const
+			{
+				::rl::math::Transform transform = frame * this->transform;
+				
+				if (::fcl::GEOM_CONE == this->geometry->getNodeType() || ::fcl::GEOM_CYLINDER == this->geometry->getNodeType())
+				{
+					transform = transform * this->base;
+				}
+				
+#if FCL_MAJOR_VERSION < 1 && FCL_MINOR_VERSION < 6
+				::fcl::Matrix3f rotation(
+					transform(0, 0), transform(0, 1), transform(0, 2),
+					transform(1, 0), transform(1, 1), transform(1, 2),
+					transform(2, 0), transform(2, 1), transform(2, 2)
+				);
+				Vector3 translation(transform(0, 3), transform(1, 3), transform(2, 3));
+				return Transform3(rotation, translation);
+#else
+				Transform3 collisionTransform;
+				collisionTransform.linear() = transform.linear();
+				collisionTransform.translation() = transform.translation();
+				return collisionTransform;
+#endif
+			}
+			
 			void
 			Shape::getTransform(::rl::math::Transform& transform)
 			{
@@ -313,25 +345,7 @@ namespace rl
 			{
 				this->frame = frame;
 				
-				::rl::math::Transform transform = this->frame * this->transform;
-				
-				if (::fcl::GEOM_CONE == this->geometry->getNodeType() || ::fcl::GEOM_CYLINDER == this->geometry->getNodeType())
-				{
-					transform = transform * this->base;
-				}
-				
-#if FCL_MAJOR_VERSION < 1 && FCL_MINOR_VERSION < 6
-				::fcl::Matrix3f rotation(
-					transform(0, 0), transform(0, 1), transform(0, 2),
-					transform(1, 0), transform(1, 1), transform(1, 2),
-					transform(2, 0), transform(2, 1), transform(2, 2)
-				);
-				Vector3 translation(transform(0, 3), transform(1, 3), transform(2, 3));
-				this->object->setTransform(rotation, translation);
-#else
-				this->object->setTransform(transform.linear(), transform.translation());
-#endif
-				
+				this->object->setTransform(this->getCollisionTransform(this->frame));
 				this->object->computeAABB();
 			}
 		}
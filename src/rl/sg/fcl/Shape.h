@@ -50,11 +50,13 @@ namespace rl
 			typedef ::fcl::CollisionGeometry CollisionGeometry;
 			typedef ::fcl::CollisionObject CollisionObject;
 			typedef ::fcl::FCL_REAL Real;
+			typedef ::fcl::Transform3f Transform3;
 			typedef ::fcl::Vec3f Vector3;
 #else
 			typedef ::fcl::CollisionGeometry<::rl::math::Real> CollisionGeometry;
 			typedef ::fcl::CollisionObject<::rl::math::Real> CollisionObject;
 			typedef ::rl::math::Real Real;
+			typedef ::fcl::Transform3<::rl::math::Real> Transform3;
 			typedef ::fcl::Vector3<::rl::math::Real> Vector3;
 #endif
 			
@@ -71,8 +73,15 @@ namespace rl
 				
 				virtual ~Shape();
 				
+				CollisionGeometry* getCollisionGeometry() const;
+				
 				CollisionObject* getCollisionObject() const;
 				
+				/**
+				 * Transform of the collision geometry for a given body frame.
+				 */
+				Transform3 getCollisionTransform(const ::rl::math::Transform& frame) const;
+				
 				void getTransform(::rl::math::Transform& transform);
 				
 				void setTransform(const ::rl::math::Transform& transform);
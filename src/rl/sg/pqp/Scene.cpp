@@ -24,6 +24,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include "Body.h"
 #include "Model.h"
 #include "Scene.h"
 #include "Shape.h"
@@ -49,6 +50,74 @@ namespace rl
 				}
 			}
 			
+			bool
+			Scene::areColliding(::rl::sg::Body* first, const ::rl::math::Transform& frame1, ::rl::sg::Body* second, const ::rl::math::Transform& frame2)
+			{
+				for (::rl::sg::Body::Iterator i = first->begin(); i != first->end(); ++i)
+				{
+					Shape* shape1 = static_cast<Shape*>(*i);
+					
+					::rl::math::Transform transform1;
+					shape1->getTransform(transform1);
+					transform1 = frame1 * transform1;
+					
+					PQP_REAL rotation1[3][3];
+					PQP_REAL translation1[3];
+					
+					for (::std::size_t k = 0; k < 3; ++k)
+					{
+						for (::std::size_t l = 0; l < 3; ++l)
+						{
+							rotation1[k][l] = static_cast<PQP_REAL>(transform1(k, l));
+						}
+						
+						translation1[k] = static_cast<PQP_REAL>(transform1(k, 3));
+					}
+					
+					for (::rl::sg::Body::Iterator j = second->begin(); j != second->end(); ++j)
+					{
+						Shape* shape2 = static_cast<Shape*>(*j);
+						
+						::rl::math::Transform transform2;
+						shape2->getTransform(transform2);
+						transform2 = frame2 * transform2;
+						
+						PQP_REAL rotation2[3][3];
+						PQP_REAL translation2[3];
+						
+						for (::std::size_t k = 0; k < 3; ++k)
+						{
+							for (::std::size_t l = 0; l < 3; ++l)
+							{
+								rotation2[k][l] = static_cast<PQP_REAL>(transform2(k, l));
+							}
+							
+							translation2[k] = static_cast<PQP_REAL>(transform2(k, 3));
+						}
+						
+						::PQP_CollideResult result;
+						
+						::PQP_Collide(
+							&result,
+							rotation1,
+							translation1,
+							&shape1->model,
+							rotation2,
+							translation2,
+							&shape2->model,
+							PQP_FIRST_CONTACT
+						);
+						
+						if (1 == result.Colliding())
+						{
+							return true;
+						}
+					}
+				}
+				
+				return false;
+			}
+			
 			bool
 			Scene::areColliding(::rl::sg::Shape* first, ::rl::sg::Shape* second)
 			{
@@ -159,6 +228,12 @@ namespace rl
 				return result.Distance();
 			}
 			
+			bool
+			Scene::isReentrant() const
+			{
+				return true;
+			}
+			
 			bool
 			Scene::isScalingSupported() const
 			{
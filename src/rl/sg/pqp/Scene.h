@@ -53,6 +53,8 @@ namespace rl
 				
 				using ::rl::sg::SimpleScene::areColliding;
 				
+				bool areColliding(::rl::sg::Body* first, const ::rl::math::Transform& frame1, ::rl::sg::Body* second, const ::rl::math::Transform& frame2);
+				
 				bool areColliding(::rl::sg::Shape* first, ::rl::sg::Shape* second);
 				
 				::rl::sg::Model* create();
@@ -63,6 +65,8 @@ namespace rl
 				
 				::rl::math::Real distance(::rl::sg::Shape* shape, const ::rl::math::Vector3& point, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2);
 				
+				bool isReentrant() const;
+				
 				bool isScalingSupported() const;
 				
 			protected:
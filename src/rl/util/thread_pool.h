@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_UTIL_THREAD_POOL_H
+#define RL_UTIL_THREAD_POOL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rl
+{
+	namespace util
+	{
+		/**
+		 * Fixed set of worker threads for fork-join parallelism.
+		 *
+		 * run() calls a function once on every worker and blocks until all of
+		 * them have returned. The calling thread acts as worker 0, so a pool of
+		 * size one never starts a thread. Calling run() from within a function
+		 * executed by the same pool results in a deadlock.
+		 */
+		class thread_pool
+		{
+		public:
+			explicit thread_pool(const ::std::size_t& size = ::std::thread::hardware_concurrency()) :
+				M_condition(),
+				M_done(),
+				M_exception(),
+				M_function(nullptr),
+				M_generation(0),
+				M_mutex(),
+				M_pending(0),
+				M_run(),
+				M_stop(false),
+				M_threads()
+			{
+				for (::std::size_t i = 1; i < ::std::max<::std::size_t>(size, 1); ++i)
+				{
+					this->M_threads.emplace_back(&thread_pool::work, this, i);
+				}
+			}
+			
+			thread_pool(const thread_pool&) = delete;
+			
+			~thread_pool()
+			{
+				{
+					::std::lock_guard<::std::mutex> lock(this->M_mutex);
+					this->M_stop = true;
+				}
+				
+				this->M_condition.notify_all();
+				
+				for (::std::size_t i = 0; i < this->M_threads.size(); ++i)
+				{
+					this->M_threads[i].join();
+				}
+			}
+			
+			thread_pool& operator=(const thread_pool&) = delete;
+			
+			/**
+			 * Call function with each worker index in [0, size()) and wait.
+			 *
+			 * The first exception thrown by any worker is rethrown.
+			 */
+			void run(const ::std::function<void(const ::std::size_t&)>& function)
+			{
+				::std::lock_guard<::std::mutex> run(this->M_run);
+				
+				{
+					::std::lock_guard<::std::mutex> lock(this->M_mutex);
+					this->M_exception = nullptr;
+					this->M_function = &function;
+					this->M_pending = this->M_threads.size();
+					++this->M_generation;
+				}
+				
+				this->M_condition.notify_all();
+				
+				this->execute(0);
+				
+				::std::unique_lock<::std::mutex> lock(this->M_mutex);
+				this->M_done.wait(lock, [this]{ return 0 == this->M_pending; });
+				this->M_function = nullptr;
+				
+				if (this->M_exception)
+				{
+					::std::rethrow_exception(this->M_exception);
+				}
+			}
+			
+			::std::size_t size() const
+			{
+				return this->M_threads.size() + 1;
+			}
+			
+		protected:
+			
+		private:
+			void execute(const ::std::size_t& i)
+			{
+				try
+				{
+					(*this->M_function)(i);
+				}
+				catch (...)
+				{
+					::std::lock_guard<::std::mutex> lock(this->M_mutex);
+					
+					if (!this->M_exception)
+					{
+						this->M_exception = ::std::current_exception();
+					}
+				}
+			}
+			
+			void work(const ::std::size_t i)
+			{
+				::std::size_t generation = 0;
+				
+				while (true)
+				{
+					{
+						::std::unique_lock<::std::mutex> lock(this->M_mutex);
+						this->M_condition.wait(lock, [this, &generation]{ return this->M_stop || generation != this->M_generation; });
+						
+						if (this->M_stop)
+						{
+							return;
+						}
+						
+						generation = this->M_generation;
+					}
+					
+					this->execute(i);
+					
+					::std::lock_guard<::std::mutex> lock(this->M_mutex);
+					
+					if (0 == --this->M_pending)
+					{
+						this->M_done.notify_one();
+					}
+				}
+			}
+			
+			::std::condition_variable M_condition;
+			
+			::std::condition_variable M_done;
+			
+			::std::exception_ptr M_exception;
+			
+			const ::std::function<void(const ::std::size_t&)>* M_function;
+			
+			::std::size_t M_generation;
+			
+			::std::mutex M_mutex;
+			
+			::std::size_t M_pending;
+			
+			::std::mutex M_run;
+			
+			bool M_stop;
+			
+			::std::vector<::std::thread> M_threads;
+		};
+	}
+}
+
+#endif // RL_UTIL_THREAD_POOL_H
@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <rl/math/TypeTraits.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/OffsetWristInverseKinematics.h>
+#include <rl/mdl/SphericalWristInverseKinematics.h>
+#include <rl/mdl/XmlFactory.h>
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		std::cout << "Usage: rlAnalyticalInverseKinematicsTest KINEMATICSFILE offset|spherical" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::string filename = argv[1];
+		std::string type = argv[2];
+		
+		rl::mdl::XmlFactory factory;
+		std::shared_ptr<rl::mdl::Kinematic> kinematics = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(filename));
+		kinematics->seed(0);
+		
+		std::shared_ptr<rl::mdl::AnalyticalInverseKinematics> ik;
+		
+		if ("offset" == type)
+		{
+			ik = std::make_shared<rl::mdl::OffsetWristInverseKinematics>(kinematics.get());
+		}
+		else if ("spherical" == type)
+		{
+			ik = std::make_shared<rl::mdl::SphericalWristInverseKinematics>(kinematics.get());
+		}
+		else
+		{
+			std::cerr << "Unknown solver type " << type << "." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		for (std::size_t n = 0; n < 1000; ++n)
+		{
+			rl::math::Vector q1 = kinematics->generatePositionUniform();
+			kinematics->setPosition(q1);
+			kinematics->forwardPosition();
+			rl::math::Transform t1 = kinematics->getOperationalPosition(0);
+			
+			rl::math::Vector q2 = kinematics->generatePositionUniform();
+			kinematics->setPosition(q2);
+			ik->clearGoals();
+			ik->addGoal(t1, 0);
+			
+			if (!ik->solve())
+			{
+				std::cerr << "Analytical inverse kinematics on file " << filename << " with no solution." << std::endl;
+				std::cerr << "t1 = " << std::endl << t1.matrix() << std::endl;
+				std::cerr << "q1 = " << q1.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			bool found = false;
+			
+			for (std::size_t i = 0; i < ik->getSolutions().size(); ++i)
+			{
+				rl::math::Vector q3 = ik->getSolutions()[i];
+				kinematics->setPosition(q3);
+				kinematics->forwardPosition();
+				rl::math::Transform t3 = kinematics->getOperationalPosition(0);
+				
+				if (t3.toDelta(t1).squaredNorm() > 1.0e-12)
+				{
+					std::cerr << "Analytical inverse kinematics on file " << filename << " with incorrect operational position." << std::endl;
+					std::cerr << "t3.toDelta(t1) = " << t3.toDelta(t1).transpose() << std::endl;
+					std::cerr << "q1 = " << q1.transpose() << std::endl;
+					std::cerr << "q3 = " << q3.transpose() << std::endl;
+					return EXIT_FAILURE;
+				}
+				
+				rl::math::Vector delta = q3 - q1;
+				
+				for (std::ptrdiff_t j = 0; j < delta.size(); ++j)
+				{
+					delta(j) = std::remainder(delta(j), 2 * rl::math::TypeTraits<rl::math::Real>::pi);
+				}
+				
+				if (delta.norm() < 1.0e-6)
+				{
+					found = true;
+				}
+			}
+			
+			if (!found)
+			{
+				std::cerr << "Analytical inverse kinematics on file " << filename << " without original configuration." << std::endl;
+				std::cerr << "q1 = " << q1.transpose() << std::endl;
+				
+				for (std::size_t i = 0; i < ik->getSolutions().size(); ++i)
+				{
+					std::cerr << "solution " << i << " = " << ik->getSolutions()[i].transpose() << std::endl;
+				}
+				
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
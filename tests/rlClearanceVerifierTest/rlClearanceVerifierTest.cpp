@@ -0,0 +1,244 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <rl/math/Unit.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/ClearanceVerifier.h>
+#include <rl/plan/DistanceModel.h>
+#include <rl/plan/RecursiveVerifier.h>
+#include <rl/plan/UniformSampler.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/XmlFactory.h>
+
+#ifdef RL_SG_BULLET
+#include <rl/sg/bullet/Scene.h>
+#endif // RL_SG_BULLET
+#ifdef RL_SG_PQP
+#include <rl/sg/pqp/Scene.h>
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+#include <rl/sg/solid/Scene.h>
+#endif // RL_SG_SOLID
+
+/**
+ * Distance model counting configurations, i.e., clearance queries of the verifier.
+ */
+class CountingModel : public rl::plan::DistanceModel
+{
+public:
+	CountingModel() :
+		DistanceModel(),
+		positions(0)
+	{
+	}
+	
+	void setPosition(const rl::math::Vector& q)
+	{
+		++this->positions;
+		DistanceModel::setPosition(q);
+	}
+	
+	std::size_t positions;
+};
+
+rl::math::Real
+clearance(rl::plan::DistanceModel& model, const rl::math::Vector& q)
+{
+	model.setPosition(q);
+	model.updateFrames();
+	
+	rl::math::Real clearance = std::numeric_limits<rl::math::Real>::max();
+	rl::math::Vector3 point1;
+	rl::math::Vector3 point2;
+	
+	for (std::size_t i = 0; i < model.getBodies(); ++i)
+	{
+		clearance = std::min(clearance, model.distance(i, point1, point2));
+	}
+	
+	return clearance;
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		std::cout << "Usage: rlClearanceVerifierTest ENGINE SCENEFILE KINEMATICSFILE" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::shared_ptr<rl::sg::Scene> scene;
+		
+#ifdef RL_SG_BULLET
+		if ("bullet" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::bullet::Scene>();
+		}
+#endif // RL_SG_BULLET
+#ifdef RL_SG_PQP
+		if ("pqp" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::pqp::Scene>();
+		}
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+		if ("solid" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::solid::Scene>();
+		}
+#endif // RL_SG_SOLID
+		
+		rl::sg::XmlFactory factory1;
+		factory1.load(argv[2], scene.get(), true, false);
+		
+		rl::mdl::XmlFactory factory2;
+		std::shared_ptr<rl::mdl::Kinematic> kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory2.create(argv[3]));
+		
+		CountingModel model;
+		model.mdl = kinematic.get();
+		model.model = scene->getModel(0);
+		model.scene = scene.get();
+		
+		rl::plan::UniformSampler sampler;
+		sampler.model = &model;
+		sampler.seed(0);
+		
+		rl::plan::ClearanceVerifier verifier;
+		verifier.delta = 1 * rl::math::DEG2RAD;
+		verifier.model = &model;
+		
+		rl::plan::RecursiveVerifier fine;
+		fine.delta = static_cast<rl::math::Real>(0.1) * rl::math::DEG2RAD;
+		fine.model = &model;
+		
+		// agreement with fine discrete verifier
+		
+		std::size_t free = 0;
+		std::size_t colliding = 0;
+		std::size_t conservative = 0;
+		std::size_t positions = 0;
+		
+		rl::math::Vector u(kinematic->getDofPosition());
+		rl::math::Vector v(kinematic->getDofPosition());
+		rl::math::Vector w(kinematic->getDofPosition());
+		
+		bool found = false;
+		rl::math::Vector u0(kinematic->getDofPosition());
+		rl::math::Vector v0(kinematic->getDofPosition());
+		
+		for (std::size_t i = 0; i < 200; ++i)
+		{
+			u = sampler.generate();
+			w = sampler.generate();
+			
+			rl::math::Real d = model.distance(u, w);
+			model.interpolate(u, w, std::min(static_cast<rl::math::Real>(1), 20 * rl::math::DEG2RAD / d), v);
+			d = model.distance(u, v);
+			
+			bool expected = model.isColliding(u) || model.isColliding(v) || fine.isColliding(u, v, d);
+			
+			model.positions = 0;
+			bool result = verifier.isColliding(u, v, d);
+			positions += model.positions;
+			
+			if (expected && !result)
+			{
+				std::cerr << "Colliding edge certified free." << std::endl;
+				std::cerr << "u = " << u.transpose() * rl::math::RAD2DEG << std::endl;
+				std::cerr << "v = " << v.transpose() * rl::math::RAD2DEG << std::endl;
+				return EXIT_FAILURE;
+			}
+			else if (expected)
+			{
+				++colliding;
+			}
+			else if (result)
+			{
+				++conservative;
+			}
+			else
+			{
+				if (!found)
+				{
+					u0 = u;
+					v0 = v;
+					found = true;
+				}
+				
+				++free;
+			}
+		}
+		
+		std::cout << "Free: " << free << "  Colliding: " << colliding << "  Not certified: " << conservative << "  Clearance queries per edge: " << static_cast<rl::math::Real>(positions) / 200 << std::endl;
+		
+		if (0 == free || 0 == colliding)
+		{
+			std::cerr << "Edges not both free and colliding." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		// subdivision stops as soon as clearance covers motion
+		
+		rl::math::Real d = model.distance(u0, v0);
+		rl::math::Real clearances = clearance(model, u0) + clearance(model, v0);
+		rl::math::Real motion = (v0 - u0).cwiseAbs().sum();
+		
+		verifier.radii = rl::math::Vector::Constant(u0.size(), static_cast<rl::math::Real>(0.1) * clearances / motion);
+		
+		model.positions = 0;
+		
+		if (verifier.isColliding(u0, v0, d) || 2 != model.positions)
+		{
+			std::cerr << "Edge covered by clearance at both ends subdivided." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		verifier.radii = rl::math::Vector::Constant(u0.size(), 1000 * clearances / motion);
+		
+		model.positions = 0;
+		
+		if (!verifier.isColliding(u0, v0, d) || model.positions <= 2)
+		{
+			std::cerr << "Edge not covered by clearance certified free." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,214 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/CollisionCache.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/plan/UniformSampler.h>
+#include <rl/sg/Body.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/SimpleScene.h>
+#include <rl/sg/XmlFactory.h>
+
+#ifdef RL_SG_BULLET
+#include <rl/sg/bullet/Scene.h>
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+#include <rl/sg/fcl/Scene.h>
+#endif // RL_SG_FCL
+#ifdef RL_SG_ODE
+#include <rl/sg/ode/Scene.h>
+#endif // RL_SG_ODE
+#ifdef RL_SG_PQP
+#include <rl/sg/pqp/Scene.h>
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+#include <rl/sg/solid/Scene.h>
+#endif // RL_SG_SOLID
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		std::cout << "Usage: rlCollisionCacheTest ENGINE SCENEFILE KINEMATICSFILE" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::shared_ptr<rl::sg::Scene> scene;
+		
+#ifdef RL_SG_BULLET
+		if ("bullet" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::bullet::Scene>();
+		}
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+		if ("fcl" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::fcl::Scene>();
+		}
+#endif // RL_SG_FCL
+#ifdef RL_SG_ODE
+		if ("ode" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::ode::Scene>();
+		}
+#endif // RL_SG_ODE
+#ifdef RL_SG_PQP
+		if ("pqp" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::pqp::Scene>();
+		}
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+		if ("solid" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::solid::Scene>();
+		}
+#endif // RL_SG_SOLID
+		
+		rl::sg::XmlFactory factory1;
+		factory1.load(argv[2], scene.get());
+		
+		rl::mdl::XmlFactory factory2;
+		std::shared_ptr<rl::mdl::Kinematic> kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory2.create(argv[3]));
+		
+		// model without cache as reference
+		rl::plan::SimpleModel reference;
+		reference.mdl = kinematic.get();
+		reference.model = scene->getModel(0);
+		reference.scene = scene.get();
+		
+		rl::plan::SimpleModel model;
+		model.cache = std::make_shared<rl::plan::CollisionCache>();
+		model.mdl = kinematic.get();
+		model.model = scene->getModel(0);
+		model.scene = scene.get();
+		model.reset();
+		
+		rl::sg::Body* obstacle = scene->getModel(1)->getBody(0);
+		
+		rl::math::Transform near;
+		obstacle->getFrame(near);
+		
+		rl::math::Transform far = near;
+		far.translation().z() += 100;
+		
+		rl::plan::UniformSampler sampler;
+		sampler.model = &reference;
+		sampler.seed(0);
+		
+		rl::math::Vector q(kinematic->getDofPosition());
+		bool found = false;
+		
+		// find configuration that only collides with the obstacle
+		for (std::size_t i = 0; i < 10000 && !found; ++i)
+		{
+			q = sampler.generate();
+			obstacle->setFrame(far);
+			
+			if (!reference.isColliding(q))
+			{
+				obstacle->setFrame(near);
+				found = reference.isColliding(q);
+			}
+		}
+		
+		if (!found)
+		{
+			std::cerr << "No configuration colliding with obstacle found." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		obstacle->setFrame(near);
+		
+		if (!model.isColliding(q) || !model.isColliding(q) || 1 != model.getCacheHits())
+		{
+			std::cerr << "Repeated query not answered by cache." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		obstacle->setFrame(far);
+		model.invalidate();
+		
+		if (model.isColliding(q))
+		{
+			std::cerr << "Cached result returned after obstacle moved away." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		obstacle->setFrame(near);
+		// reset() clears the cache as the scene changed
+		model.reset();
+		
+		if (!model.isColliding(q))
+		{
+			std::cerr << "Cached result returned after obstacle moved back." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		kinematic->world().translation().z() += 100;
+		model.invalidate();
+		
+		if (model.isColliding(q))
+		{
+			std::cerr << "Cached result returned after robot base moved away." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::math::Transform frame;
+		model.model->getBody(model.getBodies() - 1)->getFrame(frame);
+		
+		if ((frame.translation() - kinematic->getBodyFrame(model.getBodies() - 1).translation()).norm() > 1.0e-9)
+		{
+			std::cerr << "Frames of scene not updated for query." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		kinematic->world().translation().z() -= 100;
+		model.invalidate();
+		
+		if (!model.isColliding(q))
+		{
+			std::cerr << "Cached result returned after robot base moved back." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
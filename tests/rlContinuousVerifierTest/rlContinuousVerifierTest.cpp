@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <rl/math/Unit.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/ContinuousVerifier.h>
+#include <rl/plan/RecursiveVerifier.h>
+#include <rl/plan/SequentialVerifier.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/plan/UniformSampler.h>
+#include <rl/sg/Body.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/XmlFactory.h>
+
+#ifdef RL_SG_BULLET
+#include <rl/sg/bullet/Scene.h>
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+#include <rl/sg/fcl/Scene.h>
+#endif // RL_SG_FCL
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		std::cout << "Usage: rlContinuousVerifierTest ENGINE SCENEFILE KINEMATICSFILE" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::shared_ptr<rl::sg::Scene> scene;
+		
+#ifdef RL_SG_BULLET
+		if ("bullet" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::bullet::Scene>();
+		}
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+		if ("fcl" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::fcl::Scene>();
+		}
+#endif // RL_SG_FCL
+		
+		rl::sg::XmlFactory factory1;
+		factory1.load(argv[2], scene.get());
+		
+		rl::mdl::XmlFactory factory2;
+		std::shared_ptr<rl::mdl::Kinematic> kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory2.create(argv[3]));
+		
+		rl::plan::SimpleModel model;
+		model.mdl = kinematic.get();
+		model.model = scene->getModel(0);
+		model.scene = scene.get();
+		
+		rl::sg::Body* obstacle = scene->getModel(1)->getBody(0);
+		
+		rl::math::Transform near;
+		obstacle->getFrame(near);
+		
+		rl::math::Transform far = near;
+		far.translation().z() += 100;
+		
+		rl::plan::UniformSampler sampler;
+		sampler.model = &model;
+		sampler.seed(0);
+		
+		// coarse discrete verifier only checking the ends of an edge
+		rl::plan::SequentialVerifier coarse;
+		coarse.model = &model;
+		
+		rl::plan::RecursiveVerifier fine;
+		fine.delta = static_cast<rl::math::Real>(0.1) * rl::math::DEG2RAD;
+		fine.model = &model;
+		
+		rl::plan::ContinuousVerifier continuous;
+		continuous.model = &model;
+		
+		std::size_t found = 0;
+		
+		for (std::size_t i = 0; i < 10000 && found < 10; ++i)
+		{
+			rl::math::Vector q = sampler.generate();
+			
+			obstacle->setFrame(far);
+			
+			if (model.isColliding(q))
+			{
+				continue;
+			}
+			
+			obstacle->setFrame(near);
+			
+			if (!model.isColliding(q))
+			{
+				continue;
+			}
+			
+			// shortest motion of a single joint through the obstacle with free ends
+			for (std::ptrdiff_t j = 0; j < q.size(); ++j)
+			{
+				for (rl::math::Real s = 1 * rl::math::DEG2RAD; s <= 30 * rl::math::DEG2RAD; s += 1 * rl::math::DEG2RAD)
+				{
+					rl::math::Vector u = q;
+					u(j) -= s;
+					rl::math::Vector v = q;
+					v(j) += s;
+					
+					if (!model.isValid(u) || !model.isValid(v) || model.isColliding(u) || model.isColliding(v))
+					{
+						continue;
+					}
+					
+					rl::math::Real d = model.distance(u, v);
+					
+					coarse.delta = d;
+					continuous.delta = d;
+					
+					if (coarse.isColliding(u, v, d) || !fine.isColliding(u, v, d))
+					{
+						break;
+					}
+					
+					if (!continuous.isColliding(u, v, d))
+					{
+						std::cerr << "Motion through obstacle not detected by continuous verifier." << std::endl;
+						std::cerr << "u = " << u.transpose() * rl::math::RAD2DEG << std::endl;
+						std::cerr << "v = " << v.transpose() * rl::math::RAD2DEG << std::endl;
+						return EXIT_FAILURE;
+					}
+					
+					obstacle->setFrame(far);
+					
+					if (!fine.isColliding(u, v, d) && continuous.isColliding(u, v, d))
+					{
+						std::cerr << "Free motion detected as colliding by continuous verifier." << std::endl;
+						std::cerr << "u = " << u.transpose() * rl::math::RAD2DEG << std::endl;
+						std::cerr << "v = " << v.transpose() * rl::math::RAD2DEG << std::endl;
+						return EXIT_FAILURE;
+					}
+					
+					obstacle->setFrame(near);
+					
+					++found;
+					break;
+				}
+			}
+		}
+		
+		std::cout << "Motions through obstacle: " << found << std::endl;
+		
+		if (0 == found)
+		{
+			std::cerr << "No motion through obstacle found." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
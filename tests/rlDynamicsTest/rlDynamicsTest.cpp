@@ -24,13 +24,31 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <random>
 #include <stdexcept>
+#include <rl/mdl/BatchSimulator.h>
+#include <rl/mdl/DormandPrinceIntegrator.h>
 #include <rl/mdl/Dynamic.h>
+#include <rl/mdl/RungeKuttaNystromIntegrator.h>
 #include <rl/mdl/XmlFactory.h>
 
+/**
+ * Compare derivatives against central finite differences.
+ *
+ * Rounding error of finite differences grows with the magnitude of the
+ * differentiated function, not of its derivative, so the tolerance is
+ * relative to the larger of both. A purely relative comparison fails for
+ * derivatives close to zero.
+ */
+bool
+isApproxFiniteDifferences(const rl::math::Matrix& derivative, const rl::math::Matrix& finiteDifferences, const rl::math::Vector& value)
+{
+	return (derivative - finiteDifferences).norm() <= 1.0e-5 * std::max(finiteDifferences.norm(), value.norm());
+}
+
 int
 main(int argc, char** argv)
 {
@@ -47,6 +65,8 @@ main(int argc, char** argv)
 		rl::mdl::XmlFactory factory;
 		std::shared_ptr<rl::mdl::Dynamic> dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(argv[1]));
 		
+		std::shared_ptr<rl::mdl::Dynamic> copy(dynamic->clone());
+		
 		rl::math::Vector q(dynamic->getDofPosition());
 		rl::math::Vector qd(dynamic->getDof());
 		rl::math::Vector qdd(dynamic->getDof());
@@ -140,6 +160,25 @@ main(int argc, char** argv)
 			
 			rl::math::Vector tauRecursive = dynamic->getTorque();
 			
+			// inverse dynamics (copy)
+			
+			copy->setPosition(q);
+			copy->setVelocity(qd);
+			copy->setAcceleration(qdd);
+			copy->inverseDynamics();
+			
+			rl::math::Vector tauCopy = copy->getTorque();
+			
+			if (!tauCopy.isApprox(tauRecursive))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "qd = " << qd.transpose() << std::endl;
+				std::cerr << "qdd = " << qdd.transpose() << std::endl;
+				std::cerr << "tau (recursive) = " << tauRecursive.transpose() << std::endl;
+				std::cerr << "tau (copy) = " << tauCopy.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
 			// inverse dynamics (matrices)
 			
 			dynamic->setPosition(q);
@@ -162,6 +201,30 @@ main(int argc, char** argv)
 				return EXIT_FAILURE;
 			}
 			
+			// mass matrix (inverse dynamics)
+			
+			dynamic->setMassMatrixMethod(rl::mdl::Dynamic::MASS_MATRIX_METHOD_INVERSE_DYNAMICS);
+			dynamic->setPosition(q);
+			dynamic->calculateMassMatrix();
+			dynamic->setMassMatrixMethod(rl::mdl::Dynamic::MASS_MATRIX_METHOD_CRBA);
+			
+			rl::math::Matrix MInverseDynamics = dynamic->getMassMatrix();
+			
+			// mass matrix (composite rigid body)
+			
+			dynamic->setPosition(q);
+			dynamic->calculateMassMatrix();
+			
+			rl::math::Matrix MCrba = dynamic->getMassMatrix();
+			
+			if (!MCrba.isApprox(MInverseDynamics))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "M (inverse dynamics) = " << std::endl << MInverseDynamics << std::endl;
+				std::cerr << "M (composite rigid body) = " << std::endl << MCrba << std::endl;
+				return EXIT_FAILURE;
+			}
+			
 			// forward dynamics (recursive)
 			
 			dynamic->setPosition(q);
@@ -205,6 +268,222 @@ main(int argc, char** argv)
 				std::cerr << "qdd (matrices) = " << qddMatrices.transpose() << std::endl;
 				return EXIT_FAILURE;
 			}
+			
+			// mass matrix inverse (forward dynamics)
+			
+			dynamic->setMassMatrixInverseMethod(rl::mdl::Dynamic::MASS_MATRIX_INVERSE_METHOD_FORWARD_DYNAMICS);
+			dynamic->setPosition(q);
+			dynamic->calculateMassMatrixInverse();
+			dynamic->setMassMatrixInverseMethod(rl::mdl::Dynamic::MASS_MATRIX_INVERSE_METHOD_ABA);
+			
+			rl::math::Matrix invMForwardDynamics = dynamic->getMassMatrixInverse();
+			
+			// mass matrix inverse (articulated body)
+			
+			dynamic->setPosition(q);
+			dynamic->calculateMassMatrixInverse();
+			
+			rl::math::Matrix invMAba = dynamic->getMassMatrixInverse();
+			
+			if (!invMAba.isApprox(invMForwardDynamics) || !(MCrba * invMAba).isIdentity(1.0e-8))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "M^-1 (forward dynamics) = " << std::endl << invMForwardDynamics << std::endl;
+				std::cerr << "M^-1 (articulated body) = " << std::endl << invMAba << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			// inverse dynamics derivatives (recursive)
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			dynamic->setAcceleration(qdd);
+			
+			rl::math::Matrix dtaudqRecursive;
+			rl::math::Matrix dtaudqdRecursive;
+			dynamic->calculateInverseDynamicsDerivatives(dtaudqRecursive, dtaudqdRecursive);
+			
+			// forward dynamics derivatives (recursive)
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			dynamic->setTorque(tauRecursive);
+			
+			rl::math::Matrix dqdddqRecursive;
+			rl::math::Matrix dqdddqdRecursive;
+			rl::math::Matrix dqdddtauRecursive;
+			dynamic->calculateForwardDynamicsDerivatives(dqdddqRecursive, dqdddqdRecursive, dqdddtauRecursive);
+			
+			// inverse and forward dynamics derivatives (finite differences)
+			
+			rl::math::Real delta = 1.0e-6;
+			rl::math::Matrix dtaudqFiniteDifferences(dynamic->getDof(), dynamic->getDof());
+			rl::math::Matrix dtaudqdFiniteDifferences(dynamic->getDof(), dynamic->getDof());
+			rl::math::Matrix dqdddqFiniteDifferences(dynamic->getDof(), dynamic->getDof());
+			rl::math::Matrix dqdddqdFiniteDifferences(dynamic->getDof(), dynamic->getDof());
+			
+			for (std::size_t j = 0; j < dynamic->getDof(); ++j)
+			{
+				rl::math::Vector dq = rl::math::Vector::Zero(dynamic->getDof());
+				dq(j) = delta;
+				rl::math::Vector q1(dynamic->getDofPosition());
+				rl::math::Vector q2(dynamic->getDofPosition());
+				dynamic->step(q, dq, q1);
+				dynamic->step(q, -dq, q2);
+				
+				dynamic->setPosition(q1);
+				dynamic->setVelocity(qd);
+				dynamic->setAcceleration(qdd);
+				dynamic->inverseDynamics();
+				dtaudqFiniteDifferences.col(j) = dynamic->getTorque();
+				dynamic->setTorque(tauRecursive);
+				dynamic->forwardDynamics();
+				dqdddqFiniteDifferences.col(j) = dynamic->getAcceleration();
+				
+				dynamic->setPosition(q2);
+				dynamic->setAcceleration(qdd);
+				dynamic->inverseDynamics();
+				dtaudqFiniteDifferences.col(j) -= dynamic->getTorque();
+				dynamic->setTorque(tauRecursive);
+				dynamic->forwardDynamics();
+				dqdddqFiniteDifferences.col(j) -= dynamic->getAcceleration();
+				
+				dynamic->setPosition(q);
+				dynamic->setVelocity(qd + dq);
+				dynamic->setAcceleration(qdd);
+				dynamic->inverseDynamics();
+				dtaudqdFiniteDifferences.col(j) = dynamic->getTorque();
+				dynamic->setTorque(tauRecursive);
+				dynamic->forwardDynamics();
+				dqdddqdFiniteDifferences.col(j) = dynamic->getAcceleration();
+				
+				dynamic->setVelocity(qd - dq);
+				dynamic->setAcceleration(qdd);
+				dynamic->inverseDynamics();
+				dtaudqdFiniteDifferences.col(j) -= dynamic->getTorque();
+				dynamic->setTorque(tauRecursive);
+				dynamic->forwardDynamics();
+				dqdddqdFiniteDifferences.col(j) -= dynamic->getAcceleration();
+			}
+			
+			dtaudqFiniteDifferences /= 2 * delta;
+			dtaudqdFiniteDifferences /= 2 * delta;
+			dqdddqFiniteDifferences /= 2 * delta;
+			dqdddqdFiniteDifferences /= 2 * delta;
+			
+			if (!isApproxFiniteDifferences(dtaudqRecursive, dtaudqFiniteDifferences, tauRecursive) || !isApproxFiniteDifferences(dtaudqdRecursive, dtaudqdFiniteDifferences, tauRecursive))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "qd = " << qd.transpose() << std::endl;
+				std::cerr << "qdd = " << qdd.transpose() << std::endl;
+				std::cerr << "dtau/dq (recursive) = " << std::endl << dtaudqRecursive << std::endl;
+				std::cerr << "dtau/dq (finite differences) = " << std::endl << dtaudqFiniteDifferences << std::endl;
+				std::cerr << "dtau/dqd (recursive) = " << std::endl << dtaudqdRecursive << std::endl;
+				std::cerr << "dtau/dqd (finite differences) = " << std::endl << dtaudqdFiniteDifferences << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			if (!isApproxFiniteDifferences(dqdddqRecursive, dqdddqFiniteDifferences, qdd) || !isApproxFiniteDifferences(dqdddqdRecursive, dqdddqdFiniteDifferences, qdd) || !dqdddtauRecursive.isApprox(invMAba))
+			{
+				std::cerr << "q = " << q.transpose() << std::endl;
+				std::cerr << "qd = " << qd.transpose() << std::endl;
+				std::cerr << "tau = " << tauRecursive.transpose() << std::endl;
+				std::cerr << "dqdd/dq (recursive) = " << std::endl << dqdddqRecursive << std::endl;
+				std::cerr << "dqdd/dq (finite differences) = " << std::endl << dqdddqFiniteDifferences << std::endl;
+				std::cerr << "dqdd/dqd (recursive) = " << std::endl << dqdddqdRecursive << std::endl;
+				std::cerr << "dqdd/dqd (finite differences) = " << std::endl << dqdddqdFiniteDifferences << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
+		// adaptive integration
+		
+		{
+			q.setRandom();
+			qd.setRandom();
+			rl::math::Vector tau = rl::math::Vector::Random(dynamic->getDof());
+			
+			copy->setPosition(q);
+			copy->setVelocity(qd);
+			copy->setTorque(tau);
+			rl::mdl::RungeKuttaNystromIntegrator reference(copy.get());
+			
+			for (std::size_t i = 0; i < 1000; ++i)
+			{
+				reference.integrate(0.0001);
+			}
+			
+			dynamic->setPosition(q);
+			dynamic->setVelocity(qd);
+			dynamic->setTorque(tau);
+			rl::mdl::DormandPrinceIntegrator integrator(dynamic.get());
+			integrator.setAbsoluteTolerance(1.0e-10);
+			integrator.setRelativeTolerance(1.0e-10);
+			integrator.integrate(0.1);
+			
+			rl::math::Vector qInterpolated;
+			rl::math::Vector qdInterpolated;
+			integrator.interpolate(0, qInterpolated, qdInterpolated);
+			
+			if (!qInterpolated.isApprox(q) || !qdInterpolated.isApprox(qd))
+			{
+				std::cerr << "q (initial) = " << q.transpose() << std::endl;
+				std::cerr << "q (interpolated) = " << qInterpolated.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			integrator.interpolate(0.1, qInterpolated, qdInterpolated);
+			
+			if (!dynamic->getPosition().isApprox(copy->getPosition(), 1.0e-6) || !dynamic->getVelocity().isApprox(copy->getVelocity(), 1.0e-6) || !qInterpolated.isApprox(dynamic->getPosition()) || !qdInterpolated.isApprox(dynamic->getVelocity()))
+			{
+				std::cerr << "q (Runge-Kutta-Nystrom) = " << copy->getPosition().transpose() << std::endl;
+				std::cerr << "q (Dormand-Prince) = " << dynamic->getPosition().transpose() << std::endl;
+				std::cerr << "q (interpolated) = " << qInterpolated.transpose() << std::endl;
+				std::cerr << "qd (Runge-Kutta-Nystrom) = " << copy->getVelocity().transpose() << std::endl;
+				std::cerr << "qd (Dormand-Prince) = " << dynamic->getVelocity().transpose() << std::endl;
+				std::cerr << "qd (interpolated) = " << qdInterpolated.transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
+		// batch simulation
+		
+		rl::mdl::BatchSimulator simulator(4);
+		
+		for (std::size_t i = 0; i < 8; ++i)
+		{
+			std::shared_ptr<rl::mdl::Dynamic> instance(dynamic->clone());
+			instance->setPosition(rl::math::Vector::Constant(instance->getDofPosition(), 0.1 * i));
+			instance->setVelocity(rl::math::Vector::Zero(instance->getDof()));
+			std::shared_ptr<rl::mdl::Integrator> integrator = std::make_shared<rl::mdl::RungeKuttaNystromIntegrator>(instance.get());
+			
+			simulator.add(instance, integrator, [i](const rl::math::Real& /*t*/, rl::mdl::Dynamic* dynamic) {
+				dynamic->setTorque(-static_cast<rl::math::Real>(i) * dynamic->getVelocity());
+			});
+		}
+		
+		simulator.simulate(0.001, 100);
+		
+		for (std::size_t i = 0; i < simulator.getNumInstances(); ++i)
+		{
+			copy->setPosition(rl::math::Vector::Constant(copy->getDofPosition(), 0.1 * i));
+			copy->setVelocity(rl::math::Vector::Zero(copy->getDof()));
+			rl::mdl::RungeKuttaNystromIntegrator integrator(copy.get());
+			
+			for (std::size_t k = 0; k < simulator.getSteps(); ++k)
+			{
+				copy->setTorque(-static_cast<rl::math::Real>(i) * copy->getVelocity());
+				integrator.integrate(0.001);
+			}
+			
+			if (!copy->getPosition().isApprox(simulator.getPosition(i, simulator.getSteps())) || !copy->getVelocity().isApprox(simulator.getVelocity(i, simulator.getSteps())))
+			{
+				std::cerr << "q (sequential) = " << copy->getPosition().transpose() << std::endl;
+				std::cerr << "q (batch) = " << simulator.getPosition(i, simulator.getSteps()).transpose() << std::endl;
+				std::cerr << "qd (sequential) = " << copy->getVelocity().transpose() << std::endl;
+				std::cerr << "qd (batch) = " << simulator.getVelocity(i, simulator.getSteps()).transpose() << std::endl;
+				return EXIT_FAILURE;
+			}
 		}
 	}
 	catch (const std::exception& e)
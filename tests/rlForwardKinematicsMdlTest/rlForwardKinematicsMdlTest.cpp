@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2012, Andre Gaschler
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <rl/math/Transform.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/XmlFactory.h>
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlForwardKinematicsMdlTest KINEMATICFILE" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	rl::mdl::XmlFactory factory;
+	std::shared_ptr<rl::mdl::Kinematic> kinematics = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory.create(argv[1]));
+	
+	rl::math::Matrix q(kinematics->getDofPosition(), 37);
+	
+	for (std::ptrdiff_t j = 0; j < q.cols(); ++j)
+	{
+		q.col(j) = kinematics->generatePositionUniform();
+	}
+	
+	kinematics->forwardPosition(q);
+	
+	for (std::ptrdiff_t j = 0; j < q.cols(); ++j)
+	{
+		kinematics->setPosition(q.col(j));
+		kinematics->forwardPosition();
+		
+		for (std::size_t i = 0; i < kinematics->getBodies(); ++i)
+		{
+			rl::math::Transform x = kinematics->getBatchBodyFrame(i, j);
+			
+			if (!x.isApprox(kinematics->getBodyFrame(i), static_cast<rl::math::Real>(1.0e-9)))
+			{
+				std::cerr << "Batch body frame " << i << " of configuration " << j << " differs from single configuration." << std::endl;
+				std::cerr << "q: " << q.col(j).transpose() << std::endl;
+				std::cerr << "batch: " << std::endl << x.matrix() << std::endl;
+				std::cerr << "single: " << std::endl << kinematics->getBodyFrame(i).matrix() << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
+		for (std::size_t i = 0; i < kinematics->getOperationalDof(); ++i)
+		{
+			if (!kinematics->getBatchOperationalPosition(i, j).isApprox(kinematics->getOperationalPosition(i), static_cast<rl::math::Real>(1.0e-9)))
+			{
+				std::cerr << "Batch operational position " << i << " of configuration " << j << " differs from single configuration." << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	
+	return EXIT_SUCCESS;
+}
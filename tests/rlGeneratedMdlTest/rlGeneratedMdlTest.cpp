@@ -0,0 +1,252 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/XmlFactory.h>
+
+#include "UnimationPuma560.h"
+
+bool
+check(const std::string& what, const rl::math::Matrix& generated, const rl::math::Matrix& generic)
+{
+	if (!generated.isApprox(generic, static_cast<rl::math::Real>(1.0e-9)))
+	{
+		std::cerr << what << " of generated code differs from generic model." << std::endl;
+		std::cerr << "generated: " << std::endl << generated << std::endl;
+		std::cerr << "generic: " << std::endl << generic << std::endl;
+		return false;
+	}
+	
+	return true;
+}
+
+bool
+checkFiniteDifferences(const std::string& what, const rl::math::Matrix& derivative, const rl::math::Matrix& finiteDifferences, const rl::math::Vector& value)
+{
+	if ((derivative - finiteDifferences).norm() > 1.0e-5 * std::max(finiteDifferences.norm(), value.norm()))
+	{
+		std::cerr << what << " of generated code differs from finite differences." << std::endl;
+		std::cerr << "derivative: " << std::endl << derivative << std::endl;
+		std::cerr << "finite differences: " << std::endl << finiteDifferences << std::endl;
+		return false;
+	}
+	
+	return true;
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: rlGeneratedMdlTest DYNAMICFILE" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	rl::mdl::XmlFactory factory;
+	std::shared_ptr<rl::mdl::Dynamic> dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory.create(argv[1]));
+	
+	UnimationPuma560 generated;
+	factory.load(argv[1], &generated);
+	
+	for (std::size_t i = 0; i < 100; ++i)
+	{
+		rl::math::Vector q = dynamic->generatePositionUniform();
+		rl::math::Vector qd = rl::math::Vector::Random(dynamic->getDof());
+		rl::math::Vector qdd = rl::math::Vector::Random(dynamic->getDof());
+		
+		dynamic->setPosition(q);
+		dynamic->setVelocity(qd);
+		dynamic->setAcceleration(qdd);
+		generated.setPosition(q);
+		generated.setVelocity(qd);
+		generated.setAcceleration(qdd);
+		
+		dynamic->forwardPosition();
+		generated.forwardPosition();
+		
+		for (std::size_t j = 0; j < dynamic->getOperationalDof(); ++j)
+		{
+			if (!check("Operational position", generated.getOperationalPosition(j).matrix(), dynamic->getOperationalPosition(j).matrix()))
+			{
+				return EXIT_FAILURE;
+			}
+		}
+		
+		dynamic->calculateJacobian();
+		generated.calculateJacobian();
+		
+		if (!check("Jacobian", generated.getJacobian(), dynamic->getJacobian()))
+		{
+			return EXIT_FAILURE;
+		}
+		
+		dynamic->calculateJacobian(false);
+		generated.calculateJacobian(false);
+		
+		if (!check("Jacobian in tool frame", generated.getJacobian(), dynamic->getJacobian()))
+		{
+			return EXIT_FAILURE;
+		}
+		
+		dynamic->calculateMassMatrix();
+		generated.calculateMassMatrix();
+		
+		if (!check("Mass matrix", generated.getMassMatrix(), dynamic->getMassMatrix()))
+		{
+			return EXIT_FAILURE;
+		}
+		
+		dynamic->inverseDynamics();
+		generated.inverseDynamics();
+		
+		if (!check("Inverse dynamics", generated.getTorque(), dynamic->getTorque()))
+		{
+			return EXIT_FAILURE;
+		}
+		
+		rl::math::Vector tau = rl::math::Vector::Random(dynamic->getDof());
+		
+		dynamic->setTorque(tau);
+		generated.setTorque(tau);
+		
+		dynamic->forwardDynamics();
+		generated.forwardDynamics();
+		
+		if (!check("Forward dynamics", generated.getAcceleration(), dynamic->getAcceleration()))
+		{
+			return EXIT_FAILURE;
+		}
+		
+		// derivatives of generated model against finite differences of its own dynamics
+		
+		generated.setPosition(q);
+		generated.setVelocity(qd);
+		generated.setAcceleration(qdd);
+		generated.inverseDynamics();
+		rl::math::Vector tauDerivatives = generated.getTorque();
+		
+		rl::math::Matrix dtaudq;
+		rl::math::Matrix dtaudqd;
+		generated.calculateInverseDynamicsDerivatives(dtaudq, dtaudqd);
+		
+		generated.setPosition(q);
+		generated.setVelocity(qd);
+		generated.setTorque(tauDerivatives);
+		
+		rl::math::Matrix dqdddq;
+		rl::math::Matrix dqdddqd;
+		rl::math::Matrix dqdddtau;
+		generated.calculateForwardDynamicsDerivatives(dqdddq, dqdddqd, dqdddtau);
+		
+		rl::math::Real delta = 1.0e-6;
+		rl::math::Matrix dtaudqFiniteDifferences(generated.getDof(), generated.getDof());
+		rl::math::Matrix dtaudqdFiniteDifferences(generated.getDof(), generated.getDof());
+		rl::math::Matrix dqdddqFiniteDifferences(generated.getDof(), generated.getDof());
+		rl::math::Matrix dqdddqdFiniteDifferences(generated.getDof(), generated.getDof());
+		
+		for (std::size_t j = 0; j < generated.getDof(); ++j)
+		{
+			rl::math::Vector dq = rl::math::Vector::Zero(generated.getDof());
+			dq(j) = delta;
+			rl::math::Vector q1(generated.getDofPosition());
+			rl::math::Vector q2(generated.getDofPosition());
+			generated.step(q, dq, q1);
+			generated.step(q, -dq, q2);
+			
+			generated.setPosition(q1);
+			generated.setVelocity(qd);
+			generated.setAcceleration(qdd);
+			generated.inverseDynamics();
+			dtaudqFiniteDifferences.col(j) = generated.getTorque();
+			generated.setTorque(tauDerivatives);
+			generated.forwardDynamics();
+			dqdddqFiniteDifferences.col(j) = generated.getAcceleration();
+			
+			generated.setPosition(q2);
+			generated.setAcceleration(qdd);
+			generated.inverseDynamics();
+			dtaudqFiniteDifferences.col(j) -= generated.getTorque();
+			generated.setTorque(tauDerivatives);
+			generated.forwardDynamics();
+			dqdddqFiniteDifferences.col(j) -= generated.getAcceleration();
+			
+			generated.setPosition(q);
+			generated.setVelocity(qd + dq);
+			generated.setAcceleration(qdd);
+			generated.inverseDynamics();
+			dtaudqdFiniteDifferences.col(j) = generated.getTorque();
+			generated.setTorque(tauDerivatives);
+			generated.forwardDynamics();
+			dqdddqdFiniteDifferences.col(j) = generated.getAcceleration();
+			
+			generated.setVelocity(qd - dq);
+			generated.setAcceleration(qdd);
+			generated.inverseDynamics();
+			dtaudqdFiniteDifferences.col(j) -= generated.getTorque();
+			generated.setTorque(tauDerivatives);
+			generated.forwardDynamics();
+			dqdddqdFiniteDifferences.col(j) -= generated.getAcceleration();
+		}
+		
+		dtaudqFiniteDifferences /= 2 * delta;
+		dtaudqdFiniteDifferences /= 2 * delta;
+		dqdddqFiniteDifferences /= 2 * delta;
+		dqdddqdFiniteDifferences /= 2 * delta;
+		
+		if (!checkFiniteDifferences("Inverse dynamics derivative with respect to position", dtaudq, dtaudqFiniteDifferences, tauDerivatives) || !checkFiniteDifferences("Inverse dynamics derivative with respect to velocity", dtaudqd, dtaudqdFiniteDifferences, tauDerivatives))
+		{
+			return EXIT_FAILURE;
+		}
+		
+		if (!checkFiniteDifferences("Forward dynamics derivative with respect to position", dqdddq, dqdddqFiniteDifferences, qdd) || !checkFiniteDifferences("Forward dynamics derivative with respect to velocity", dqdddqd, dqdddqdFiniteDifferences, qdd))
+		{
+			return EXIT_FAILURE;
+		}
+		
+		dynamic->setPosition(q);
+		dynamic->setVelocity(qd);
+		dynamic->setTorque(tauDerivatives);
+		
+		rl::math::Matrix dqdddqGeneric;
+		rl::math::Matrix dqdddqdGeneric;
+		rl::math::Matrix dqdddtauGeneric;
+		dynamic->calculateForwardDynamicsDerivatives(dqdddqGeneric, dqdddqdGeneric, dqdddtauGeneric);
+		
+		if (!check("Forward dynamics derivative with respect to torque", dqdddtau, dqdddtauGeneric))
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,225 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/Joint.h>
+#include <rl/mdl/Transform.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/Model.h>
+#include <rl/sg/Body.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/XmlFactory.h>
+
+#ifdef RL_SG_BULLET
+#include <rl/sg/bullet/Scene.h>
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+#include <rl/sg/fcl/Scene.h>
+#endif // RL_SG_FCL
+#ifdef RL_SG_ODE
+#include <rl/sg/ode/Scene.h>
+#endif // RL_SG_ODE
+#ifdef RL_SG_PQP
+#include <rl/sg/pqp/Scene.h>
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+#include <rl/sg/solid/Scene.h>
+#endif // RL_SG_SOLID
+
+#include "UnimationPuma560.h"
+
+bool
+check(const rl::plan::Model& model, const rl::mdl::Model& reference)
+{
+	for (std::size_t i = 0; i < model.getBodies(); ++i)
+	{
+		rl::math::Transform frame;
+		model.model->getBody(i)->getFrame(frame);
+		
+		if (!frame.matrix().isApprox(reference.getBodyFrame(i).matrix(), static_cast<rl::math::Real>(1.0e-9)))
+		{
+			std::cerr << "Frame of body " << i << " in scene differs from model." << std::endl;
+			std::cerr << "scene: " << std::endl << frame.matrix() << std::endl;
+			std::cerr << "model: " << std::endl << reference.getBodyFrame(i).matrix() << std::endl;
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		std::cout << "Usage: rlGeneratedPlanModelTest ENGINE SCENEFILE DYNAMICFILE" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::shared_ptr<rl::sg::Scene> scene;
+		
+#ifdef RL_SG_BULLET
+		if ("bullet" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::bullet::Scene>();
+		}
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+		if ("fcl" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::fcl::Scene>();
+		}
+#endif // RL_SG_FCL
+#ifdef RL_SG_ODE
+		if ("ode" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::ode::Scene>();
+		}
+#endif // RL_SG_ODE
+#ifdef RL_SG_PQP
+		if ("pqp" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::pqp::Scene>();
+		}
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+		if ("solid" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::solid::Scene>();
+		}
+#endif // RL_SG_SOLID
+		
+		rl::sg::XmlFactory factory1;
+		factory1.load(argv[2], scene.get());
+		
+		rl::mdl::XmlFactory factory2;
+		std::shared_ptr<rl::mdl::Dynamic> dynamic = std::dynamic_pointer_cast<rl::mdl::Dynamic>(factory2.create(argv[3]));
+		
+		UnimationPuma560 generated;
+		factory2.load(argv[3], &generated);
+		
+		// generic model passes only recalculated frames after single joint changes
+		{
+			rl::plan::Model incremental;
+			incremental.mdl = dynamic.get();
+			incremental.model = scene->getModel(0);
+			incremental.scene = scene.get();
+			
+			rl::math::Vector q = dynamic->generatePositionUniform();
+			
+			for (std::size_t i = 0; i < 100; ++i)
+			{
+				std::size_t j = i % dynamic->getDofPosition();
+				q(j) = dynamic->generatePositionUniform()(j);
+				
+				incremental.setPosition(q);
+				incremental.updateFrames();
+				
+				generated.setPosition(q);
+				generated.forwardPosition();
+				
+				if (!check(incremental, generated))
+				{
+					return EXIT_FAILURE;
+				}
+			}
+		}
+		
+		rl::plan::Model model;
+		model.mdl = &generated;
+		model.model = scene->getModel(0);
+		model.scene = scene.get();
+		
+		// generated forwardPosition() marks all body frames as recalculated
+		for (std::size_t i = 0; i < 100; ++i)
+		{
+			rl::math::Vector q = dynamic->generatePositionUniform();
+			
+			dynamic->setPosition(q);
+			dynamic->forwardPosition();
+			
+			model.setPosition(q);
+			model.updateFrames();
+			
+			if (!check(model, *dynamic))
+			{
+				return EXIT_FAILURE;
+			}
+		}
+		
+		rl::mdl::Transform* transform = nullptr;
+		
+		for (std::size_t i = 0; i < generated.getTransforms() && nullptr == transform; ++i)
+		{
+			if (nullptr == dynamic_cast<rl::mdl::Joint*>(generated.getTransform(i)))
+			{
+				transform = generated.getTransform(i);
+			}
+		}
+		
+		if (nullptr == transform)
+		{
+			std::cerr << "No fixed transform found." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::math::Transform before;
+		model.model->getBody(model.getBodies() - 1)->getFrame(before);
+		
+		// modify transform directly instead of through world() or tool()
+		transform->x.translation().z() += 1;
+		
+		model.updateFrames();
+		
+		if (!check(model, generated))
+		{
+			return EXIT_FAILURE;
+		}
+		
+		rl::math::Transform after;
+		model.model->getBody(model.getBodies() - 1)->getFrame(after);
+		
+		if ((after.translation() - before.translation()).norm() < 0.5)
+		{
+			std::cerr << "Modified transform not passed to scene." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
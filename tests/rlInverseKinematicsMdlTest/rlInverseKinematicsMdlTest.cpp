@@ -29,6 +29,7 @@
 #include <stdexcept>
 #include <rl/mdl/JacobianInverseKinematics.h>
 #include <rl/mdl/Kinematic.h>
+#include <rl/mdl/ParallelInverseKinematics.h>
 #include <rl/mdl/XmlFactory.h>
 
 #ifdef RL_MDL_NLOPT
@@ -69,6 +70,18 @@ main(int argc, char** argv)
 		jacobianTranspose->setMethod(rl::mdl::JacobianInverseKinematics::METHOD_TRANSPOSE);
 		ik.push_back(std::make_pair(jacobianTranspose, "rl::mdl::JacobianInverseKinematics::METHOD_TRANSPOSE"));
 		
+		std::shared_ptr<rl::mdl::ParallelInverseKinematics> parallel = std::make_shared<rl::mdl::ParallelInverseKinematics>(
+			kinematics.get(),
+			[](rl::mdl::Kinematic* kinematic) {
+				rl::mdl::JacobianInverseKinematics* jacobian = new rl::mdl::JacobianInverseKinematics(kinematic);
+				jacobian->setIterations(100);
+				return jacobian;
+			},
+			4
+		);
+		parallel->seed(0);
+		ik.push_back(std::make_pair(parallel, "rl::mdl::ParallelInverseKinematics"));
+		
 #ifdef RL_MDL_NLOPT
 		std::shared_ptr<rl::mdl::NloptInverseKinematics> nlopt = std::make_shared<rl::mdl::NloptInverseKinematics>(kinematics.get());
 		nlopt->seed(0);
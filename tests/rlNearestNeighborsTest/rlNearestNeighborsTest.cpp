@@ -85,6 +85,107 @@ test(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Ve
 	return results;
 }
 
+template<typename NearestNeighbors>
+void
+testBatch(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Vector>& queries, const std::vector<std::vector<typename NearestNeighbors::Neighbor>>& expected)
+{
+	std::vector<const rl::math::Vector*> points2;
+	points2.reserve(points.size());
+	
+	for (std::size_t i = 0; i < points.size(); ++i)
+	{
+		points2.push_back(&points[i]);
+	}
+	
+	std::vector<const rl::math::Vector*> queries2;
+	queries2.reserve(queries.size());
+	
+	for (std::size_t i = 0; i < queries.size(); ++i)
+	{
+		queries2.push_back(&queries[i]);
+	}
+	
+	NearestNeighbors nearestNeighbors(points2.begin(), points2.end());
+	
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::vector<std::vector<typename NearestNeighbors::Neighbor>> neighbors = nearestNeighbors.nearest(queries2, K);
+	std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+	
+	std::cout << "batch search time (" << queries.size() << ") " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000 << " ms" << std::endl;
+	
+	std::vector<typename NearestNeighbors::Distance> radii(queries.size());
+	
+	for (std::size_t i = 0; i < queries.size(); ++i)
+	{
+		if (neighbors[i].size() != expected[i].size())
+		{
+			std::cerr << "rlNearestNeighborsTest: batch nearest [" << i << "] size " << neighbors[i].size() << " != " << expected[i].size() << std::endl;
+			exit(EXIT_FAILURE);
+		}
+		
+		for (std::size_t j = 0; j < expected[i].size(); ++j)
+		{
+			if (!Eigen::internal::isApprox(expected[i][j].first, neighbors[i][j].first))
+			{
+				std::cerr << "rlNearestNeighborsTest: batch nearest [" << i << "][" << j << "] " << neighbors[i][j].first << " != " << expected[i][j].first << std::endl;
+				exit(EXIT_FAILURE);
+			}
+		}
+		
+		radii[i] = expected[i].empty() ? 0 : expected[i].back().first;
+	}
+	
+	for (std::size_t i = 0; i < queries.size(); ++i)
+	{
+		// radius of k-th neighbor returns all closer neighbors of expected result
+		std::vector<typename NearestNeighbors::Neighbor> closer = nearestNeighbors.radius(queries2[i], radii[i]);
+		std::size_t count = 0;
+		
+		while (count < expected[i].size() && expected[i][count].first < radii[i])
+		{
+			++count;
+		}
+		
+		if (closer.size() != count)
+		{
+			std::cerr << "rlNearestNeighborsTest: radius [" << i << "] size " << closer.size() << " != " << count << std::endl;
+			exit(EXIT_FAILURE);
+		}
+		
+		for (std::size_t j = 0; j < closer.size(); ++j)
+		{
+			if (!Eigen::internal::isApprox(expected[i][j].first, closer[j].first))
+			{
+				std::cerr << "rlNearestNeighborsTest: radius [" << i << "][" << j << "] " << closer[j].first << " != " << expected[i][j].first << std::endl;
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+	
+	typename NearestNeighbors::Distance radius = expected.front().back().first;
+	std::vector<std::vector<typename NearestNeighbors::Neighbor>> within = nearestNeighbors.radius(queries2, radius);
+	
+	for (std::size_t i = 0; i < queries.size(); ++i)
+	{
+		std::vector<typename NearestNeighbors::Neighbor> single = nearestNeighbors.radius(queries2[i], radius);
+		
+		if (within[i].size() != single.size())
+		{
+			std::cerr << "rlNearestNeighborsTest: batch radius [" << i << "] size " << within[i].size() << " != " << single.size() << std::endl;
+			exit(EXIT_FAILURE);
+		}
+		
+		for (std::size_t j = 0; j < single.size(); ++j)
+		{
+			if (within[i][j].first >= radius || !Eigen::internal::isApprox(within[i][j].first, single[j].first))
+			{
+				std::cerr << "rlNearestNeighborsTest: batch radius [" << i << "][" << j << "] " << within[i][j].first << " != " << single[j].first << std::endl;
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+}
+
 void
 test(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Vector>& queries, const bool& iterative)
 {
@@ -147,6 +248,9 @@ test(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Ve
 			}
 		}
 	}
+	
+	std::cout << "** GnatNearestNeighbors<Metric> (batch) ***************************************" << std::endl;
+	testBatch<rl::math::GnatNearestNeighbors<Metric>>(points, queries, linear);
 }
 
 int
@@ -0,0 +1,226 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <rl/plan/ParallelPlanner.h>
+
+/**
+ * Planner that finds a path after a given time, checking for expiry like
+ * the sampling-based planners.
+ */
+class TimedPlanner : public rl::plan::Planner
+{
+public:
+	TimedPlanner(const std::chrono::steady_clock::duration& solution) :
+		Planner(),
+		solution(solution),
+		stopped(),
+		path()
+	{
+	}
+	
+	std::string getName() const
+	{
+		return "Timed";
+	}
+	
+	rl::plan::VectorList getPath()
+	{
+		return this->path;
+	}
+	
+	void reset()
+	{
+		this->canceled = false;
+		this->path.clear();
+	}
+	
+	bool solve()
+	{
+		this->time = std::chrono::steady_clock::now();
+		
+		while (!this->isExpired())
+		{
+			if (std::chrono::steady_clock::now() - this->time >= this->solution)
+			{
+				this->path.push_back(*this->start);
+				this->path.push_back(*this->goal);
+				this->stopped = std::chrono::steady_clock::now();
+				return true;
+			}
+			
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		
+		this->stopped = std::chrono::steady_clock::now();
+		
+		return false;
+	}
+	
+	std::chrono::steady_clock::duration solution;
+	
+	std::chrono::steady_clock::time_point stopped;
+	
+private:
+	rl::plan::VectorList path;
+};
+
+int
+main(int argc, char** argv)
+{
+	std::chrono::steady_clock::duration never = std::chrono::hours(1);
+	
+	TimedPlanner planner0(never);
+	TimedPlanner planner1(std::chrono::milliseconds(100));
+	TimedPlanner planner2(never);
+	TimedPlanner planner3(never);
+	
+	rl::plan::ParallelPlanner parallel;
+	parallel.planners.push_back(&planner0);
+	parallel.planners.push_back(&planner1);
+	parallel.planners.push_back(&planner2);
+	parallel.planners.push_back(&planner3);
+	
+	rl::math::Vector start = rl::math::Vector::Zero(2);
+	rl::math::Vector goal = rl::math::Vector::Ones(2);
+	
+	parallel.start = &start;
+	parallel.goal = &goal;
+	
+	// one planner solves, the others are canceled
+	
+	parallel.duration = std::chrono::seconds(60);
+	parallel.reset();
+	
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	bool solved = parallel.solve();
+	std::chrono::steady_clock::time_point stopTime = std::chrono::steady_clock::now();
+	
+	std::cout << "solve() " << (solved ? "true" : "false") << " " << std::chrono::duration_cast<std::chrono::duration<double>>(stopTime - startTime).count() * 1000 << " ms" << std::endl;
+	
+	if (!solved || &planner1 != parallel.getSolver() || 2 != parallel.getPath().size())
+	{
+		std::cerr << "Path of solving planner not returned." << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	for (std::size_t i = 0; i < parallel.planners.size(); ++i)
+	{
+		TimedPlanner* planner = static_cast<TimedPlanner*>(parallel.planners[i]);
+		
+		if (&planner1 == planner)
+		{
+			continue;
+		}
+		
+		if (!planner->isCanceled())
+		{
+			std::cerr << "Planner " << i << " not canceled." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (planner->stopped - planner1.stopped > std::chrono::seconds(1))
+		{
+			std::cerr << "Planner " << i << " not stopped promptly after cancel." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	if (stopTime - startTime > std::chrono::seconds(5))
+	{
+		std::cerr << "solve() did not return promptly after a planner solved." << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	// no planner solves within duration
+	
+	planner1.solution = never;
+	
+	parallel.duration = std::chrono::milliseconds(500);
+	parallel.reset();
+	
+	startTime = std::chrono::steady_clock::now();
+	solved = parallel.solve();
+	stopTime = std::chrono::steady_clock::now();
+	
+	std::cout << "solve() " << (solved ? "true" : "false") << " " << std::chrono::duration_cast<std::chrono::duration<double>>(stopTime - startTime).count() * 1000 << " ms" << std::endl;
+	
+	if (solved || nullptr != parallel.getSolver() || !parallel.getPath().empty())
+	{
+		std::cerr << "Path returned after duration expired." << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	if (stopTime - startTime < parallel.duration || stopTime - startTime > std::chrono::seconds(5))
+	{
+		std::cerr << "solve() did not return after duration expired." << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	for (std::size_t i = 0; i < parallel.planners.size(); ++i)
+	{
+		if (parallel.planners[i]->isCanceled())
+		{
+			std::cerr << "Planner " << i << " canceled without solution." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	// cancel from another thread
+	
+	parallel.duration = std::chrono::seconds(60);
+	parallel.reset();
+	
+	std::thread thread([&parallel]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		parallel.cancel();
+	});
+	
+	startTime = std::chrono::steady_clock::now();
+	solved = parallel.solve();
+	stopTime = std::chrono::steady_clock::now();
+	
+	thread.join();
+	
+	std::cout << "solve() " << (solved ? "true" : "false") << " " << std::chrono::duration_cast<std::chrono::duration<double>>(stopTime - startTime).count() * 1000 << " ms" << std::endl;
+	
+	if (solved || nullptr != parallel.getSolver())
+	{
+		std::cerr << "Path returned after cancel." << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	if (stopTime - startTime > std::chrono::seconds(5))
+	{
+		std::cerr << "solve() did not return promptly after cancel." << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
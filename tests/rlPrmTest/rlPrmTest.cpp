@@ -24,6 +24,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <cstdio>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
@@ -31,12 +32,14 @@
 #include <rl/math/Unit.h>
 #include <rl/mdl/Kinematic.h>
 #include <rl/mdl/XmlFactory.h>
+#include <rl/plan/Exception.h>
 #include <rl/plan/KdtreeNearestNeighbors.h>
 #include <rl/plan/Prm.h>
 #include <rl/plan/RecursiveVerifier.h>
 #include <rl/plan/SimpleModel.h>
 #include <rl/plan/SimpleOptimizer.h>
 #include <rl/plan/UniformSampler.h>
+#include <rl/plan/VectorList.h>
 #include <rl/sg/Model.h>
 #include <rl/sg/XmlFactory.h>
 
@@ -181,6 +184,96 @@ main(int argc, char** argv)
 		
 		std::cout << "NumVertices: " << planner.getNumVertices() << "  NumEdges: " << planner.getNumEdges() << std::endl;
 		
+		std::string filename = std::string("rlPrmTest-") + argv[1];
+		
+		for (int i = 12; i < argc; ++i)
+		{
+			filename += std::string("_") + argv[i];
+		}
+		
+		filename += ".prm";
+		
+		planner.save(filename);
+		
+		rl::plan::KdtreeNearestNeighbors nearestNeighbors2(&model);
+		rl::plan::Prm planner2;
+		planner2.model = &model;
+		planner2.setNearestNeighbors(&nearestNeighbors2);
+		planner2.sampler = &sampler;
+		planner2.verifier = &verifier;
+		planner2.start = &start;
+		planner2.goal = &goal;
+		planner2.duration = std::chrono::seconds(20);
+		planner2.load(filename);
+		
+		if (planner.getNumVertices() != planner2.getNumVertices() || planner.getNumEdges() != planner2.getNumEdges())
+		{
+			std::cerr << "NumVertices and NumEdges of loaded roadmap differ: " << planner2.getNumVertices() << " " << planner2.getNumEdges() << std::endl;
+			std::remove(filename.c_str());
+			return EXIT_FAILURE;
+		}
+		
+		if (solved && !planner2.solve())
+		{
+			std::cerr << "solve() of loaded roadmap differs." << std::endl;
+			std::remove(filename.c_str());
+			return EXIT_FAILURE;
+		}
+		
+		kinematic->world().translation().x() += 1;
+		
+		try
+		{
+			planner2.load(filename);
+			std::cerr << "Roadmap loaded for different kinematics." << std::endl;
+			std::remove(filename.c_str());
+			return EXIT_FAILURE;
+		}
+		catch (const rl::plan::Exception& e)
+		{
+			std::cout << e.what() << std::endl;
+		}
+		
+		kinematic->world().translation().x() -= 1;
+		
+		std::remove(filename.c_str());
+		
+		rl::plan::KdtreeNearestNeighbors nearestNeighbors3(&model);
+		rl::plan::Prm planner3;
+		planner3.lazy = true;
+		planner3.model = &model;
+		planner3.setNearestNeighbors(&nearestNeighbors3);
+		planner3.sampler = &sampler;
+		planner3.verifier = &verifier;
+		planner3.start = &start;
+		planner3.goal = &goal;
+		planner3.duration = std::chrono::seconds(20);
+		
+		std::cout << "solve() lazy ... " << std::endl;
+		startTime = std::chrono::steady_clock::now();
+		bool solvedLazy = planner3.solve();
+		stopTime = std::chrono::steady_clock::now();
+		std::cout << "solve() lazy " << (solvedLazy ? "true" : "false") << " " << std::chrono::duration_cast<std::chrono::duration<double>>(stopTime - startTime).count() * 1000 << " ms" << std::endl;
+		
+		std::cout << "NumVertices: " << planner3.getNumVertices() << "  NumEdges: " << planner3.getNumEdges() << std::endl;
+		
+		if (!solvedLazy)
+		{
+			std::cerr << "solve() of lazy roadmap failed." << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		rl::plan::VectorList path = planner3.getPath();
+		
+		for (rl::plan::VectorList::iterator i = path.begin(), j = ++path.begin(); j != path.end(); ++i, ++j)
+		{
+			if (verifier.isColliding(*i, *j, model.distance(*i, *j)))
+			{
+				std::cerr << "Path of lazy roadmap is colliding." << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
 		if (solved)
 		{
 			if (boost::lexical_cast<std::size_t>(argv[4]) >= planner.getNumVertices() &&
@@ -0,0 +1,240 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <boost/lexical_cast.hpp>
+#include <rl/math/Unit.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/KdtreeNearestNeighbors.h>
+#include <rl/plan/RecursiveVerifier.h>
+#include <rl/plan/RrtStar.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/plan/UniformSampler.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/XmlFactory.h>
+
+#ifdef RL_SG_BULLET
+#include <rl/sg/bullet/Scene.h>
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+#include <rl/sg/fcl/Scene.h>
+#endif // RL_SG_FCL
+#ifdef RL_SG_ODE
+#include <rl/sg/ode/Scene.h>
+#endif // RL_SG_ODE
+#ifdef RL_SG_PQP
+#include <rl/sg/pqp/Scene.h>
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+#include <rl/sg/solid/Scene.h>
+#endif // RL_SG_SOLID
+
+int
+main(int argc, char** argv)
+{
+	if (argc < 22)
+	{
+		std::cout << "Usage: rlRrtStarTest ENGINE SCENEFILE KINEMATICSFILE X Y Z A B C START1 ... STARTn GOAL1 ... GOALn" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		std::shared_ptr<rl::sg::Scene> scene;
+		
+#ifdef RL_SG_BULLET
+		if ("bullet" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::bullet::Scene>();
+		}
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+		if ("fcl" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::fcl::Scene>();
+		}
+#endif // RL_SG_FCL
+#ifdef RL_SG_ODE
+		if ("ode" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::ode::Scene>();
+		}
+#endif // RL_SG_ODE
+#ifdef RL_SG_PQP
+		if ("pqp" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::pqp::Scene>();
+		}
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+		if ("solid" == std::string(argv[1]))
+		{
+			scene = std::make_shared<rl::sg::solid::Scene>();
+		}
+#endif // RL_SG_SOLID
+		
+		rl::sg::XmlFactory factory1;
+		factory1.load(argv[2], scene.get());
+		
+		rl::mdl::XmlFactory factory2;
+		std::shared_ptr<rl::mdl::Kinematic> kinematic = std::dynamic_pointer_cast<rl::mdl::Kinematic>(factory2.create(argv[3]));
+		
+		rl::math::Transform world = rl::math::Transform::Identity();
+		
+		world = rl::math::AngleAxis(
+			boost::lexical_cast<rl::math::Real>(argv[9]) * ::rl::math::DEG2RAD,
+			::rl::math::Vector3::UnitZ()
+		) * ::rl::math::AngleAxis(
+			boost::lexical_cast<rl::math::Real>(argv[8]) * ::rl::math::DEG2RAD,
+			::rl::math::Vector3::UnitY()
+		) * ::rl::math::AngleAxis(
+			boost::lexical_cast<rl::math::Real>(argv[7]) * ::rl::math::DEG2RAD,
+			::rl::math::Vector3::UnitX()
+		);
+		
+		world.translation().x() = boost::lexical_cast<rl::math::Real>(argv[4]);
+		world.translation().y() = boost::lexical_cast<rl::math::Real>(argv[5]);
+		world.translation().z() = boost::lexical_cast<rl::math::Real>(argv[6]);
+		
+		kinematic->world() = world;
+		
+		rl::plan::SimpleModel model;
+		model.mdl = kinematic.get();
+		model.model = scene->getModel(0);
+		model.scene = scene.get();
+		
+		rl::plan::KdtreeNearestNeighbors nearestNeighbors(&model);
+		rl::plan::RrtStar planner;
+		rl::plan::UniformSampler sampler;
+		rl::plan::RecursiveVerifier verifier;
+		
+		planner.delta = 10 * rl::math::DEG2RAD;
+		planner.model = &model;
+		planner.setNearestNeighbors(&nearestNeighbors, 0);
+		planner.sampler = &sampler;
+		planner.verifier = &verifier;
+		
+		sampler.model = &model;
+		
+		verifier.delta = 1 * rl::math::DEG2RAD;
+		verifier.model = &model;
+		
+		rl::math::Vector start(kinematic->getDofPosition());
+		
+		for (std::ptrdiff_t i = 0; i < start.size(); ++i)
+		{
+			start(i) = boost::lexical_cast<rl::math::Real>(argv[i + 10]) * rl::math::DEG2RAD;
+		}
+		
+		planner.start = &start;
+		
+		rl::math::Vector goal(kinematic->getDofPosition());
+		
+		for (std::ptrdiff_t i = 0; i < goal.size(); ++i)
+		{
+			goal(i) = boost::lexical_cast<rl::math::Real>(argv[start.size() + i + 10]) * rl::math::DEG2RAD;
+		}
+		
+		planner.goal = &goal;
+		
+		rl::math::Real cost = std::numeric_limits<rl::math::Real>::infinity();
+		
+		// same samples in every run, longer runs continue shorter ones
+		for (std::size_t i = 1; i <= 3; ++i)
+		{
+			planner.duration = std::chrono::seconds(3 * i);
+			planner.reset();
+			planner.seed(0);
+			sampler.seed(0);
+			
+			std::cout << "solve() ... " << std::endl;;
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+			bool solved = planner.solve();
+			std::chrono::steady_clock::time_point stopTime = std::chrono::steady_clock::now();
+			std::cout << "solve() " << (solved ? "true" : "false") << " " << std::chrono::duration_cast<std::chrono::duration<double>>(stopTime - startTime).count() * 1000 << " ms" << std::endl;
+			
+			std::cout << "NumVertices: " << planner.getNumVertices() << "  NumEdges: " << planner.getNumEdges() << "  Cost: " << planner.getCost() << std::endl;
+			
+			if (!solved)
+			{
+				std::cerr << "solve() failed." << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			rl::plan::VectorList path = planner.getPath();
+			
+			if ((path.front() - start).norm() > planner.epsilon || (path.back() - goal).norm() > planner.epsilon)
+			{
+				std::cerr << "Path does not connect start and goal." << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			rl::math::Real length = 0;
+			rl::plan::VectorList::iterator j = path.begin();
+			rl::plan::VectorList::iterator k = ++path.begin();
+			
+			for (; j != path.end() && k != path.end(); ++j, ++k)
+			{
+				rl::math::Real distance = model.distance(*j, *k);
+				
+				if (model.isColliding(*k) || verifier.isColliding(*j, *k, distance))
+				{
+					std::cerr << "Path is colliding." << std::endl;
+					return EXIT_FAILURE;
+				}
+				
+				length += distance;
+			}
+			
+			if (std::abs(length - planner.getCost()) > 1.0e-6)
+			{
+				std::cerr << "Path length " << length << " differs from cost " << planner.getCost() << "." << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			if (planner.getCost() > cost + 1.0e-9)
+			{
+				std::cerr << "Cost increased from " << cost << " to " << planner.getCost() << " with more iterations." << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			cost = planner.getCost();
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}